@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+#include <libfork/core/ext/tls.hpp>
+#include <libfork/core/impl/frame.hpp>
+#include <libfork/core/impl/stack.hpp>
+#include <libfork/core/macro.hpp>
+
+// Compare the bytes per fork (the size of each coroutine frame on the stack) of libfork's frame layouts.
+//
+// The `fib_libfork` benchmark measures libfork's real frames, in whichever layout this build uses, from the
+// high-water mark of a `unit_pool` worker's stack. The mirrored layouts need no stacklet to construct, they
+// compare the previous layout, which stored an `std::exception_ptr` in every frame, with the current layout
+// with and without `LF_COROUTINE_OFFSET`. Like libfork's stacks the allocations are rounded up to
+// `k_new_align` hence `bytes_per_fork` may exceed `coro_bytes`.
+
+namespace {
+
+inline constexpr volatile int work = 24;
+volatile int output;
+
+// ----------------------- A bump allocator that records its high-water mark ----------------------- //
+
+thread_local std::byte *asp;
+thread_local std::byte *high;
+thread_local std::size_t coro_bytes;
+
+struct op {
+
+  [[nodiscard]] static auto operator new(std::size_t size) -> void * {
+    coro_bytes = size;
+    auto *prev = asp;
+    asp += (size + lf::impl::k_new_align - 1) & ~(lf::impl::k_new_align - 1);
+    high = std::max(high, asp);
+    return prev;
+  }
+
+  static void operator delete(void *ptr) { asp = static_cast<std::byte *>(ptr); }
+};
+
+// ----------------------- Frames ----------------------- //
+
+// The previous layout, with the exception state in line.
+struct inline_exception_frame {
+
+  explicit inline_exception_frame(std::coroutine_handle<> coro) : m_this_coro{coro} {}
+
+  std::exception_ptr m_eptr;
+  std::coroutine_handle<> m_this_coro;
+  void *m_stacklet = nullptr;
+  void *m_parent = nullptr;
+  std::atomic_uint16_t m_join = lf::impl::k_u16_max;
+  std::uint16_t m_steal = 0;
+  bool m_except = false;
+};
+
+// The current layout without LF_COROUTINE_OFFSET, mirrored such that no stacklet is needed to construct it.
+struct compact_frame {
+
+  explicit compact_frame(std::coroutine_handle<> coro) : m_this_coro{coro} {}
+
+  std::coroutine_handle<> m_this_coro;
+  void *m_stacklet = nullptr;
+  void *m_parent = nullptr;
+  std::atomic_uint16_t m_join = lf::impl::k_u16_max;
+  std::uint16_t m_steal = 0;
+  bool m_except = false;
+};
+
+// The current layout with LF_COROUTINE_OFFSET, the coroutine handle is inferred from `this`.
+struct compact_offset_frame {
+
+  explicit compact_offset_frame(std::coroutine_handle<> /* unused */) {}
+
+  void *m_stacklet = nullptr;
+  void *m_parent = nullptr;
+  std::atomic_uint16_t m_join = lf::impl::k_u16_max;
+  std::uint16_t m_steal = 0;
+  bool m_except = false;
+};
+
+#ifdef LF_COROUTINE_OFFSET
+using current_frame = compact_offset_frame;
+#else
+using current_frame = compact_frame;
+#endif
+
+static_assert(sizeof(current_frame) == sizeof(lf::impl::frame));
+static_assert(alignof(current_frame) == alignof(lf::impl::frame));
+
+static_assert(sizeof(compact_offset_frame) < sizeof(compact_frame));
+static_assert(sizeof(compact_frame) < sizeof(inline_exception_frame));
+
+// ----------------------- Fib ----------------------- //
+
+template <typename Frame>
+struct promise;
+
+template <typename Frame>
+struct LF_CORO_ATTRIBUTES coroutine : std::coroutine_handle<promise<Frame>> {
+  using promise_type = promise<Frame>;
+};
+
+template <typename Frame>
+struct promise : Frame, op {
+
+  promise() : Frame(coroutine<Frame>::from_promise(*this)) {}
+
+  auto get_return_object() -> coroutine<Frame> { return {coroutine<Frame>::from_promise(*this)}; }
+  static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+  static auto final_suspend() noexcept -> std::suspend_never { return {}; }
+  static void return_void() {}
+  static void unhandled_exception() { LF_ASSERT(false && "Unreachable"); }
+};
+
+template <typename Frame>
+auto fib_impl(int &ret, int n) -> coroutine<Frame> {
+  if (n < 2) {
+    ret = n;
+    co_return;
+  }
+
+  int a, b;
+
+  fib_impl<Frame>(a, n - 1).resume();
+  fib_impl<Frame>(b, n - 2).resume();
+
+  ret = a + b;
+}
+
+template <typename Frame>
+void fib(benchmark::State &state) {
+
+  std::vector<std::byte> stack(1024 * 1024);
+
+  asp = stack.data();
+  high = stack.data();
+
+  for (auto _ : state) {
+    int tmp;
+    auto h = fib_impl<Frame>(tmp, work);
+    h.resume();
+    output = tmp;
+  }
+
+  // The deepest chain of frames in fib(n) is n frames long.
+  state.counters["sizeof(frame)"] = sizeof(Frame);
+  state.counters["coro_bytes"] = coro_bytes;
+  state.counters["bytes_per_fork"] = static_cast<double>(high - stack.data()) / work;
+}
+
+// ----------------------- Fib with libfork's frames ----------------------- //
+
+std::byte *high_water;
+
+// The current stack pointer of the calling worker's stack.
+auto stack_top() -> std::byte * {
+  auto *stack = lf::impl::tls::stack();
+  void *ptr = stack->allocate(1);
+  stack->deallocate(ptr);
+  return static_cast<std::byte *>(ptr);
+}
+
+template <bool Probe>
+constexpr auto lf_fib = [](auto fib, int &ret, int n) LF_STATIC_CALL -> lf::task<void> {
+  if (n < 2) {
+    if constexpr (Probe) {
+      high_water = std::max(high_water, stack_top());
+    }
+    ret = n;
+    co_return;
+  }
+
+  int a, b;
+
+  co_await lf::fork(fib)(a, n - 1);
+  co_await lf::call(fib)(b, n - 2);
+  co_await lf::join;
+
+  ret = a + b;
+};
+
+constexpr auto probe_fib = [](auto, int n) LF_STATIC_CALL -> lf::task<std::ptrdiff_t> {
+  //
+  std::byte *base = stack_top();
+  high_water = base;
+
+  int tmp;
+  co_await lf::call(lf_fib<true>)(tmp, n);
+
+  co_return high_water - base;
+};
+
+// The high-water mark of the stack while running fib(n), relative to the stack pointer of its caller.
+auto high_water_mark(lf::unit_pool &sch, int n) -> std::ptrdiff_t { return lf::sync_wait(sch, probe_fib, n); }
+
+void fib_libfork(benchmark::State &state) {
+
+  lf::unit_pool sch;
+
+  for (auto _ : state) {
+    int tmp;
+    lf::sync_wait(sch, lf_fib<false>, tmp, work);
+    output = tmp;
+  }
+
+  // The deepest chain of frames in fib(n) is one frame longer than in fib(n - 1), the root frames cancel.
+  // Both chains must fit in a worker's first stacklet (a page) else the high-water mark is meaningless.
+  constexpr int k_shallow = 4;
+  constexpr int k_deep = 12;
+
+  std::ptrdiff_t shallow = high_water_mark(sch, k_shallow);
+  std::ptrdiff_t deep = high_water_mark(sch, k_deep);
+
+#ifdef LF_COROUTINE_OFFSET
+  state.counters["LF_COROUTINE_OFFSET"] = LF_COROUTINE_OFFSET;
+#endif
+  state.counters["sizeof(frame)"] = sizeof(lf::impl::frame);
+  state.counters["bytes_per_fork"] = static_cast<double>(deep - shallow) / (k_deep - k_shallow);
+}
+
+} // namespace
+
+BENCHMARK(fib<inline_exception_frame>);
+BENCHMARK(fib<compact_frame>);
+BENCHMARK(fib<compact_offset_frame>);
+BENCHMARK(fib_libfork)->UseRealTime();
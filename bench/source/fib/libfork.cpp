@@ -22,7 +22,28 @@ constexpr auto fib = [](auto fib, int n) LF_STATIC_CALL -> lf::task<int> {
   co_return a + b;
 };
 
-template <lf::scheduler Sch, lf::numa_strategy Strategy>
+// Child-stealing, both children are pushed to a group and then launched.
+struct fib_child_fn {
+  LF_STATIC_CALL auto operator()(auto /* unused */, int n) LF_STATIC_CONST -> lf::task<int> {
+    if (n < 2) {
+      co_return n;
+    }
+
+    lf::deferred_group<fib_child_fn, int> group{{}};
+
+    group.push(n - 1);
+    group.push(n - 2);
+
+    co_await group.call();
+    co_await lf::join;
+
+    co_return group[0] + group[1];
+  }
+};
+
+constexpr fib_child_fn fib_child = {};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, auto Fib = fib>
 void fib_libfork(benchmark::State &state) {
 
   state.counters["green_threads"] = state.range(0);
@@ -40,7 +61,7 @@ void fib_libfork(benchmark::State &state) {
   volatile int output;
 
   for (auto _ : state) {
-    output = lf::sync_wait(sch, fib, secret);
+    output = lf::sync_wait(sch, Fib, secret);
   }
 
 #ifndef LF_NO_CHECK
@@ -61,4 +82,9 @@ BENCHMARK(fib_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime
 BENCHMARK(fib_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
 
 BENCHMARK(fib_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
-BENCHMARK(fib_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
\ No newline at end of file
+BENCHMARK(fib_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+// Continuation-stealing (above) vs child-stealing, see also integrate_flat_libfork.
+
+BENCHMARK(fib_libfork<lazy_pool, numa_strategy::seq, fib_child>)->Apply(targs)->UseRealTime();
+BENCHMARK(fib_libfork<busy_pool, numa_strategy::seq, fib_child>)->Apply(targs)->UseRealTime();
@@ -62,6 +62,79 @@ void integrate_libfork(benchmark::State &state) {
   std::cout << "error: " << out << "!=" << expect << std::endl;
 }
 
+/**
+ * @brief How the children of a flat loop are launched.
+ */
+enum class policy {
+  continuation,
+  child,
+};
+
+// Integrate [0, n) as `n` unit intervals launched from a single task.
+template <policy Policy>
+constexpr auto integrate_flat = [](auto) LF_STATIC_CALL -> task<double> {
+  //
+  std::vector<double> area(n);
+
+  if constexpr (Policy == policy::continuation) {
+    for (int i = 0; i < n; ++i) {
+      co_await lf::fork(&area[i], integrate)(i, fn(i), i + 1, fn(i + 1), 0);
+    }
+    co_await lf::join;
+  } else {
+    deferred_group<decltype(integrate), double, double, double, double, double> group{integrate};
+
+    for (int i = 0; i < n; ++i) {
+      group.push(i, fn(i), i + 1, fn(i + 1), 0);
+    }
+
+    co_await group.call();
+    co_await lf::join;
+
+    for (int i = 0; i < n; ++i) {
+      area[i] = group[i];
+    }
+  }
+
+  double sum = 0;
+
+  for (double elem : area) {
+    sum += elem;
+  }
+
+  co_return sum;
+};
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy, policy Policy>
+void integrate_flat_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = state.range(0);
+  state.counters["integrate_n"] = n;
+  state.counters["integrate_epsilon"] = epsilon;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  volatile double out;
+
+  for (auto _ : state) {
+    out = sync_wait(sch, integrate_flat<Policy>);
+  }
+
+  double expect = integral_fn(0, n);
+
+  if (out - expect < n * epsilon && expect - out < n * epsilon) {
+    return;
+  }
+
+  std::cout << "error: " << out << "!=" << expect << std::endl;
+}
+
 } // namespace
 
 using namespace lf;
@@ -70,3 +143,18 @@ BENCHMARK(integrate_libfork<lazy_pool, numa_strategy::seq>)->Apply(targs)->UseRe
 BENCHMARK(integrate_libfork<busy_pool, numa_strategy::seq>)->Apply(targs)->UseRealTime();
 BENCHMARK(integrate_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
 BENCHMARK(integrate_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+// A wide, flat loop launched from one task: continuation-stealing vs child-stealing.
+
+BENCHMARK(integrate_flat_libfork<lazy_pool, numa_strategy::seq, policy::continuation>)
+    ->Apply(targs)
+    ->UseRealTime();
+BENCHMARK(integrate_flat_libfork<lazy_pool, numa_strategy::seq, policy::child>)
+    ->Apply(targs)
+    ->UseRealTime();
+BENCHMARK(integrate_flat_libfork<busy_pool, numa_strategy::seq, policy::continuation>)
+    ->Apply(targs)
+    ->UseRealTime();
+BENCHMARK(integrate_flat_libfork<busy_pool, numa_strategy::seq, policy::child>)
+    ->Apply(targs)
+    ->UseRealTime();
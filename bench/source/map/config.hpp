@@ -0,0 +1,31 @@
+#ifndef A4F17C3E_92D0_4B5A_8E61_C07D3B9F2A15
+#define A4F17C3E_92D0_4B5A_8E61_C07D3B9F2A15
+
+#include <vector>
+
+inline constexpr std::size_t map_n /**/ = 10'000'000;
+inline constexpr std::size_t map_chunk = 64 * 1024;
+inline constexpr float map_a = 2.5F;
+
+/**
+ * @brief The kernel, one step of a saxpy.
+ */
+inline constexpr auto saxpy = [](float x) -> float {
+  return map_a * x + 1.0F;
+};
+
+inline auto make_vec_map() -> std::vector<float> {
+
+  std::vector<float> out(map_n);
+
+  float count = 0;
+
+  for (auto &&elem : out) {
+    elem = count;
+    count += 0.5F;
+  }
+
+  return out;
+}
+
+#endif /* A4F17C3E_92D0_4B5A_8E61_C07D3B9F2A15 */
@@ -0,0 +1,49 @@
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+using namespace lf;
+
+namespace {
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void map_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = map_n;
+  state.counters["chunk"] = map_chunk;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector<float> in = lf::sync_wait(sch, lf::lift, make_vec_map);
+  std::vector<float> ou = in;
+
+  for (auto _ : state) {
+    lf::sync_wait(sch, lf::map, in, ou.begin(), map_chunk, saxpy);
+  }
+
+#ifndef LF_NO_CHECK
+  for (std::size_t i = 0; i < map_n; ++i) {
+    if (ou[i] != saxpy(in[i])) {
+      throw std::runtime_error("Map failed");
+    }
+  }
+#endif
+}
+
+} // namespace
+
+BENCHMARK(map_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(map_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
@@ -0,0 +1,38 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void map_omp(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = map_n;
+
+  std::vector<float> in = make_vec_map();
+  std::vector<float> ou = in;
+
+  float const *src = in.data();
+  float *dst = ou.data();
+
+  auto n = static_cast<long>(map_n);
+
+  for (auto _ : state) {
+#pragma omp parallel for simd num_threads(state.range(0)) schedule(static)
+    for (long i = 0; i < n; ++i) {
+      dst[i] = saxpy(src[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+
+  volatile float sink = ou.back();
+
+  ignore(sink);
+}
+
+} // namespace
+
+BENCHMARK(map_omp)->Apply(targs)->UseRealTime();
@@ -0,0 +1,31 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void map_serial(benchmark::State &state) {
+
+  state.counters["n"] = map_n;
+
+  std::vector<float> in = make_vec_map();
+  std::vector<float> ou = in;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < map_n; ++i) {
+      ou[i] = saxpy(in[i]);
+    }
+    benchmark::ClobberMemory();
+  }
+
+  volatile float sink = ou.back();
+
+  ignore(sink);
+}
+
+} // namespace
+
+BENCHMARK(map_serial)->UseRealTime();
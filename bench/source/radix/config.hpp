@@ -0,0 +1,24 @@
+#ifndef F47A2C90_3D18_4B6E_A5C1_09E8B7D6F213
+#define F47A2C90_3D18_4B6E_A5C1_09E8B7D6F213
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+inline constexpr std::size_t radix_n /**/ = 10'000'000;
+inline constexpr std::size_t radix_chunk = 64 * 1024;
+
+inline auto make_vec_radix() -> std::vector<std::uint32_t> {
+
+  std::vector<std::uint32_t> out(radix_n);
+
+  std::mt19937 rng{42};
+
+  for (auto &&elem : out) {
+    elem = rng();
+  }
+
+  return out;
+}
+
+#endif /* F47A2C90_3D18_4B6E_A5C1_09E8B7D6F213 */
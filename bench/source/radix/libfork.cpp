@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+using namespace lf;
+
+namespace {
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void radix_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = radix_n;
+  state.counters["chunk"] = radix_chunk;
+
+  Sch sch = [&] {
+    if constexpr (std::constructible_from<Sch, int>) {
+      return Sch(state.range(0));
+    } else {
+      return Sch{};
+    }
+  }();
+
+  std::vector<std::uint32_t> in = lf::sync_wait(sch, lf::lift, make_vec_radix);
+  std::vector<std::uint32_t> ou = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::ranges::copy(in, ou.begin());
+    state.ResumeTiming();
+
+    lf::sync_wait(sch, lf::radix_sort, ou, radix_chunk);
+  }
+
+#ifndef LF_NO_CHECK
+  if (!std::ranges::is_sorted(ou)) {
+    throw std::runtime_error("Radix sort failed");
+  }
+#endif
+}
+
+} // namespace
+
+BENCHMARK(radix_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(radix_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
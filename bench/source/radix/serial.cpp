@@ -0,0 +1,34 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void radix_serial(benchmark::State &state) {
+
+  state.counters["n"] = radix_n;
+
+  std::vector<std::uint32_t> in = make_vec_radix();
+  std::vector<std::uint32_t> ou = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::ranges::copy(in, ou.begin());
+    state.ResumeTiming();
+
+    std::ranges::sort(ou);
+  }
+
+  volatile std::uint32_t sink = ou.back();
+
+  ignore(sink);
+}
+
+} // namespace
+
+BENCHMARK(radix_serial)->UseRealTime();
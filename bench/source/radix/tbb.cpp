@@ -0,0 +1,47 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void radix_tbb(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = radix_n;
+
+  std::size_t n = state.range(0);
+  tbb::task_arena arena(n);
+
+  std::vector<std::uint32_t> in = make_vec_radix();
+  std::vector<std::uint32_t> ou = in;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::ranges::copy(in, ou.begin());
+    state.ResumeTiming();
+
+    arena.execute([&] {
+      tbb::parallel_sort(ou.begin(), ou.end());
+    });
+  }
+
+#ifndef LF_NO_CHECK
+  if (!std::ranges::is_sorted(ou)) {
+    throw std::runtime_error("TBB sort failed");
+  }
+#endif
+}
+
+} // namespace
+
+BENCHMARK(radix_tbb)->Apply(targs)->UseRealTime();
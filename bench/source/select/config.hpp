@@ -0,0 +1,26 @@
+#ifndef D83E1A6C_5B27_4F90_8C4D_A1F6E2B9073C
+#define D83E1A6C_5B27_4F90_8C4D_A1F6E2B9073C
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+inline constexpr std::size_t select_n /**/ = 10'000'000;
+inline constexpr std::size_t select_nth = select_n / 3;
+inline constexpr std::size_t select_k /**/ = 1000;
+inline constexpr std::size_t select_chunk = 64 * 1024;
+
+inline auto make_vec_select() -> std::vector<std::uint32_t> {
+
+  std::vector<std::uint32_t> out(select_n);
+
+  std::mt19937 rng{42};
+
+  for (auto &&elem : out) {
+    elem = rng();
+  }
+
+  return out;
+}
+
+#endif /* D83E1A6C_5B27_4F90_8C4D_A1F6E2B9073C */
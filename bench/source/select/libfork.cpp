@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <libfork.hpp>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+using namespace lf;
+
+namespace {
+
+template <lf::scheduler Sch>
+auto make_sch(benchmark::State &state) -> Sch {
+  if constexpr (std::constructible_from<Sch, int>) {
+    return Sch(state.range(0));
+  } else {
+    return Sch{};
+  }
+}
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void nth_element_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = select_n;
+  state.counters["chunk"] = select_chunk;
+
+  Sch sch = make_sch<Sch>(state);
+
+  std::vector<std::uint32_t> in = lf::sync_wait(sch, lf::lift, make_vec_select);
+  std::vector<std::uint32_t> ou = in;
+
+  auto nth = static_cast<std::ptrdiff_t>(select_nth);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::ranges::copy(in, ou.begin());
+    state.ResumeTiming();
+
+    lf::sync_wait(sch, lf::nth_element, ou, ou.begin() + nth, select_chunk);
+  }
+
+#ifndef LF_NO_CHECK
+  std::ranges::nth_element(in, in.begin() + nth);
+
+  if (ou[select_nth] != in[select_nth]) {
+    throw std::runtime_error("Nth element failed");
+  }
+#endif
+}
+
+template <lf::scheduler Sch, lf::numa_strategy Strategy>
+void top_k_libfork(benchmark::State &state) {
+
+  state.counters["green_threads"] = static_cast<double>(state.range(0));
+  state.counters["n"] = select_n;
+  state.counters["k"] = select_k;
+  state.counters["chunk"] = select_chunk;
+
+  Sch sch = make_sch<Sch>(state);
+
+  std::vector<std::uint32_t> in = lf::sync_wait(sch, lf::lift, make_vec_select);
+  std::vector<std::uint32_t> ou(select_k);
+
+  for (auto _ : state) {
+    lf::sync_wait(sch, lf::top_k, in, ou.begin(), select_k, select_chunk);
+  }
+
+#ifndef LF_NO_CHECK
+  std::ranges::partial_sort(in, in.begin() + select_k, std::ranges::greater{});
+
+  if (!std::ranges::equal(ou, in | std::views::take(select_k))) {
+    throw std::runtime_error("Top k failed");
+  }
+#endif
+}
+
+} // namespace
+
+BENCHMARK(nth_element_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(nth_element_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+
+BENCHMARK(top_k_libfork<lazy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
+BENCHMARK(top_k_libfork<busy_pool, numa_strategy::fan>)->Apply(targs)->UseRealTime();
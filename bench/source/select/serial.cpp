@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../util.hpp"
+#include "config.hpp"
+
+namespace {
+
+void nth_element_serial(benchmark::State &state) {
+
+  state.counters["n"] = select_n;
+
+  std::vector<std::uint32_t> in = make_vec_select();
+  std::vector<std::uint32_t> ou = in;
+
+  auto nth = static_cast<std::ptrdiff_t>(select_nth);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::ranges::copy(in, ou.begin());
+    state.ResumeTiming();
+
+    std::nth_element(ou.begin(), ou.begin() + nth, ou.end());
+  }
+
+  volatile std::uint32_t sink = ou[select_nth];
+
+  ignore(sink);
+}
+
+void top_k_serial(benchmark::State &state) {
+
+  state.counters["n"] = select_n;
+  state.counters["k"] = select_k;
+
+  std::vector<std::uint32_t> in = make_vec_select();
+  std::vector<std::uint32_t> ou(select_k);
+
+  for (auto _ : state) {
+    std::ranges::partial_sort_copy(in, ou, std::ranges::greater{});
+  }
+
+  volatile std::uint32_t sink = ou.back();
+
+  ignore(sink);
+}
+
+} // namespace
+
+BENCHMARK(nth_element_serial)->UseRealTime();
+
+BENCHMARK(top_k_serial)->UseRealTime();
@@ -101,12 +101,12 @@ inline constexpr auto uts = [](auto uts, int depth, Node *parent) LF_STATIC_CALL
   co_return r;
 };
 
-template <lf::scheduler Sch, lf::numa_strategy Strategy>
+template <lf::scheduler Sch, lf::numa_strategy Strategy, lf::steal_policy Policy = lf::steal_policy::random>
 void uts_libfork_alloc(benchmark::State &state, int tree) {
 
   state.counters["green_threads"] = state.range(0);
 
-  Sch sch(state.range(0));
+  Sch sch(state.range(0), Strategy, Policy);
 
   setup_tree(tree);
 
@@ -125,12 +125,12 @@ void uts_libfork_alloc(benchmark::State &state, int tree) {
   }
 }
 
-template <lf::scheduler Sch, lf::numa_strategy Strategy>
+template <lf::scheduler Sch, lf::numa_strategy Strategy, lf::steal_policy Policy = lf::steal_policy::random>
 void uts_libfork(benchmark::State &state, int tree) {
 
   state.counters["green_threads"] = state.range(0);
 
-  Sch sch(state.range(0));
+  Sch sch(state.range(0), Strategy, Policy);
 
   setup_tree(tree);
 
@@ -166,6 +166,16 @@ void uts_libfork_coalloc_busy_fan(benchmark::State &state, int tree) {
   uts_libfork<lf::busy_pool, lf::numa_strategy::fan>(state, tree);
 }
 
+// Leapfrogging
+
+void uts_libfork_leapfrog_lazy_fan(benchmark::State &state, int tree) {
+  uts_libfork<lf::lazy_pool, lf::numa_strategy::fan, lf::steal_policy::leapfrog>(state, tree);
+}
+
+void uts_libfork_leapfrog_busy_fan(benchmark::State &state, int tree) {
+  uts_libfork<lf::busy_pool, lf::numa_strategy::fan, lf::steal_policy::leapfrog>(state, tree);
+}
+
 // Allocating
 
 void uts_libfork_alloc_lazy_seq(benchmark::State &state, int tree) {
@@ -197,3 +207,6 @@ MAKE_UTS_FOR(uts_libfork_coalloc_lazy_seq);
 MAKE_UTS_FOR(uts_libfork_coalloc_lazy_fan);
 MAKE_UTS_FOR(uts_libfork_coalloc_busy_seq);
 MAKE_UTS_FOR(uts_libfork_coalloc_busy_fan);
+
+MAKE_UTS_FOR(uts_libfork_leapfrog_lazy_fan);
+MAKE_UTS_FOR(uts_libfork_leapfrog_busy_fan);
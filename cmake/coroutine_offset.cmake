@@ -0,0 +1,33 @@
+# Detect the ABI offset between a coroutine's handle and its promise for the active compiler, on success
+# LF_DETECTED_COROUTINE_OFFSET is set to the offset otherwise it is empty. The result is cached.
+
+if(DEFINED LF_DETECTED_COROUTINE_OFFSET)
+  return()
+endif()
+
+if(CMAKE_CROSSCOMPILING)
+  message(STATUS "Cross compiling, LF_COROUTINE_OFFSET not detected")
+  set(LF_DETECTED_COROUTINE_OFFSET "" CACHE INTERNAL "")
+  return()
+endif()
+
+try_run(
+  LF_COROUTINE_OFFSET_RUN_RESULT
+  LF_COROUTINE_OFFSET_COMPILE_RESULT
+  "${CMAKE_CURRENT_BINARY_DIR}/coroutine_offset"
+  "${CMAKE_CURRENT_LIST_DIR}/coroutine_offset.cpp"
+  CXX_STANDARD 23
+  CXX_STANDARD_REQUIRED ON
+  RUN_OUTPUT_VARIABLE LF_COROUTINE_OFFSET_OUTPUT
+)
+
+if(LF_COROUTINE_OFFSET_COMPILE_RESULT
+   AND LF_COROUTINE_OFFSET_RUN_RESULT EQUAL 0
+   AND LF_COROUTINE_OFFSET_OUTPUT MATCHES "^[0-9]+$"
+)
+  message(STATUS "Detected LF_COROUTINE_OFFSET=${LF_COROUTINE_OFFSET_OUTPUT}")
+  set(LF_DETECTED_COROUTINE_OFFSET "${LF_COROUTINE_OFFSET_OUTPUT}" CACHE INTERNAL "")
+else()
+  message(STATUS "LF_COROUTINE_OFFSET not detected, frames will store a coroutine handle")
+  set(LF_DETECTED_COROUTINE_OFFSET "" CACHE INTERNAL "")
+endif()
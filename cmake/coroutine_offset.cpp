@@ -0,0 +1,73 @@
+// Prints the offset (bytes) from a coroutine's handle address to its promise, this is the value libfork
+// needs for LF_COROUTINE_OFFSET. Exits with a non-zero status if the offset is not the same for every
+// probed promise, in which case it is not safe to use.
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdio>
+
+namespace {
+
+template <std::size_t Align, std::size_t Size>
+struct probe {
+
+  struct promise_type {
+    auto get_return_object() noexcept -> probe {
+      return {std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    static auto final_suspend() noexcept -> std::suspend_always { return {}; }
+    static void return_void() noexcept {}
+    static void unhandled_exception() noexcept {}
+
+    alignas(Align) unsigned char bytes[Size];
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+template <std::size_t Align, std::size_t Size>
+auto empty() -> probe<Align, Size> {
+  co_return;
+}
+
+template <std::size_t Align, std::size_t Size>
+auto with_state(int a, double b) -> probe<Align, Size> {
+  volatile double c = a * b;
+  co_await std::suspend_always{};
+  c = c + 1;
+}
+
+template <typename Probe>
+auto offset(Probe coro) -> std::ptrdiff_t {
+  auto *promise = reinterpret_cast<unsigned char *>(&coro.handle.promise());
+  auto *address = static_cast<unsigned char *>(coro.handle.address());
+  coro.handle.destroy();
+  return promise - address;
+}
+
+} // namespace
+
+auto main() -> int {
+
+  constexpr std::size_t ptr = alignof(void *);
+
+  std::ptrdiff_t const offsets[] = {
+      offset(empty<ptr, 4 * ptr>()),
+      offset(empty<ptr, 3 * ptr>()),
+      offset(with_state<ptr, 4 * ptr>(1, 2)),
+      offset(with_state<ptr, 3 * ptr>(3, 4)),
+      offset(empty<2 * ptr, 4 * ptr>()),
+      offset(with_state<2 * ptr, 4 * ptr>(5, 6)),
+  };
+
+  for (std::ptrdiff_t off : offsets) {
+    if (off != offsets[0] || off <= 0) {
+      return 1;
+    }
+  }
+
+  std::printf("%td", offsets[0]);
+
+  return 0;
+}
@@ -13,11 +13,21 @@
 #include "libfork/schedule.hpp"
 
 #include "libfork/algorithm/constraints.hpp"
+#include "libfork/algorithm/deterministic_fold.hpp"
+#include "libfork/algorithm/exclusive_scan.hpp"
 #include "libfork/algorithm/fold.hpp"
 #include "libfork/algorithm/for_each.hpp"
+#include "libfork/algorithm/for_each_nd.hpp"
+#include "libfork/algorithm/generate.hpp"
+#include "libfork/algorithm/histogram.hpp"
 #include "libfork/algorithm/lift.hpp"
 #include "libfork/algorithm/map.hpp"
+#include "libfork/algorithm/merge.hpp"
+#include "libfork/algorithm/nth_element.hpp"
+#include "libfork/algorithm/radix_sort.hpp"
 #include "libfork/algorithm/scan.hpp"
+#include "libfork/algorithm/scan_by_key.hpp"
+#include "libfork/algorithm/views.hpp"
 
 /**
  * @file libfork.hpp
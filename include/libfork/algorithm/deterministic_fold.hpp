@@ -0,0 +1,476 @@
+#ifndef A7FDBE86_95F4_0F58_39B2_FCF17DEF8171
+#define A7FDBE86_95F4_0F58_39B2_FCF17DEF8171
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min
+#include <cmath>       // for abs
+#include <concepts>    // for floating_point, invocable, copy_constructible
+#include <cstddef>     // for ptrdiff_t
+#include <functional>  // for identity, invoke, plus
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_reference_t
+#include <optional>    // for optional, nullopt
+#include <ranges>      // for begin, end, iterator_t, random_access_range, sized_range
+#include <type_traits> // for invoke_result_t, remove_cvref_t
+#include <utility>     // for move
+
+#include "libfork/algorithm/constraints.hpp" // for indirectly_foldable, indirect_fold_acc_t, projected
+#include "libfork/core/control_flow.hpp"     // for call, fork, join
+#include "libfork/core/eventually.hpp"       // for eventually
+#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"             // for task
+
+/**
+ * @file deterministic_fold.hpp
+ *
+ * @brief Reductions with an association order that depends only on the length of the input.
+ */
+
+namespace lf {
+
+/**
+ * @brief The number of elements folded sequentially in each leaf of a deterministic reduction.
+ *
+ * This is part of the contract of `lf::deterministic_fold` and `lf::deterministic_sum`, changing it changes
+ * their results.
+ */
+inline constexpr std::ptrdiff_t deterministic_block = 1024;
+
+namespace impl {
+
+/**
+ * @brief Test if `Bop` and `Proj` are regular (not async) functions that fold the elements of `I`.
+ */
+template <typename Bop, typename I, typename Proj>
+concept deterministically_foldable =
+    indirectly_foldable<Bop, projected<I, Proj>> &&                                                //
+    std::copy_constructible<Proj> &&                                                               //
+    std::invocable<Proj &, std::iter_reference_t<I>> &&                                            //
+    std::invocable<Bop &, indirect_fold_acc_t<Bop, I, Proj>, indirect_fold_acc_t<Bop, I, Proj>> && //
+    std::invocable<Bop &,
+                   indirect_fold_acc_t<Bop, I, Proj>,
+                   std::invoke_result_t<Proj &, std::iter_reference_t<I>>>;
+
+/**
+ * @brief Test if `Proj` is a regular function that maps the elements of `I` to a floating point type.
+ */
+template <typename I, typename Proj>
+concept deterministically_summable =
+    std::copy_constructible<Proj> &&                    //
+    std::invocable<Proj &, std::iter_reference_t<I>> && //
+    std::floating_point<std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>>;
+
+namespace detail {
+
+/**
+ * @brief The default chunk size of the deterministic reductions.
+ */
+inline constexpr std::ptrdiff_t k_deterministic_grain = 16 * 1024;
+
+/**
+ * @brief The number of blocks in a subtree that is evaluated sequentially, for a chunk size of `n`.
+ */
+constexpr auto grain_blocks(std::ptrdiff_t n) noexcept -> std::ptrdiff_t {
+  return std::max<std::ptrdiff_t>(1, n / deterministic_block);
+}
+
+/**
+ * @brief The floating point type summed by `lf::deterministic_sum`.
+ */
+template <typename I, typename Proj>
+using summand_t = std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>;
+
+/**
+ * @brief A fixed reduction tree over the blocks `[lo, hi)`, it is halved until it is a single block.
+ *
+ * Subtrees of at most `grain` blocks are evaluated sequentially, the association order is the same.
+ */
+template <typename Acc>
+struct block_tree {
+  /**
+   * @brief Evaluate a subtree sequentially.
+   */
+  template <typename Leaf, typename Combine>
+  static auto serial(std::ptrdiff_t lo, std::ptrdiff_t hi, Leaf &leaf, Combine &combine) -> Acc {
+
+    if (hi - lo == 1) {
+      return std::invoke(leaf, lo);
+    }
+
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+
+    Acc lhs = serial(lo, mid, leaf, combine);
+    Acc rhs = serial(mid, hi, leaf, combine);
+
+    return std::invoke(combine, std::move(lhs), std::move(rhs));
+  }
+
+  /**
+   * @brief Evaluate a subtree, in parallel if it has more than `grain` blocks.
+   */
+  template <std::copy_constructible Leaf, std::copy_constructible Combine>
+  LF_STATIC_CALL auto operator()(auto tree,
+                                 std::ptrdiff_t lo,
+                                 std::ptrdiff_t hi,
+                                 std::ptrdiff_t grain,
+                                 Leaf leaf,
+                                 Combine combine) LF_STATIC_CONST->lf::task<Acc> {
+
+    LF_ASSERT(lo < hi);
+    LF_ASSERT(grain > 0);
+
+    if (hi - lo <= grain) {
+      co_return serial(lo, hi, leaf, combine);
+    }
+
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+
+    eventually<Acc> lhs;
+    eventually<Acc> rhs;
+
+    // clang-format off
+
+    co_await lf::fork(&lhs, tree)(lo, mid, grain, leaf, combine);
+
+    LF_TRY {
+      co_await lf::call(&rhs, tree)(mid, hi, grain, leaf, combine);
+    } LF_CATCH_ALL {
+      tree.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    co_return std::invoke(combine, *std::move(lhs), *std::move(rhs));
+  }
+};
+
+/**
+ * @brief A sum and its running compensation (the low order bits lost from the sum).
+ */
+template <std::floating_point T>
+struct compensated {
+  /**
+   * @brief Add `x` to `sum` and accumulate the rounding error in `comp` (Neumaier's variant of Kahan).
+   */
+  constexpr void add(T x) noexcept {
+
+    T tmp = sum + x;
+
+    if (std::abs(sum) >= std::abs(x)) {
+      comp += (sum - tmp) + x;
+    } else {
+      comp += (x - tmp) + sum;
+    }
+
+    sum = tmp;
+  }
+
+  /**
+   * @brief Combine two compensated sums, the error of adding the sums is compensated as well.
+   */
+  friend constexpr auto operator+(compensated lhs, compensated const &rhs) noexcept -> compensated {
+    lhs.comp += rhs.comp;
+    lhs.add(rhs.sum);
+    return lhs;
+  }
+
+  /**
+   * @brief The compensated value.
+   */
+  [[nodiscard]] constexpr auto value() const noexcept -> T { return sum + comp; }
+
+  /**
+   * @brief The running sum.
+   */
+  T sum = 0;
+  /**
+   * @brief The running compensation.
+   */
+  T comp = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::deterministic_fold`.
+ */
+struct deterministic_fold_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Bop,
+            typename Proj = std::identity>
+    requires deterministically_foldable<Bop, I, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, I, Proj>>> {
+
+    LF_ASSERT(n > 0);
+
+    using acc_t = indirect_fold_acc_t<Bop, I, Proj>;
+
+    std::ptrdiff_t len = tail - head;
+
+    LF_ASSERT(len >= 0);
+
+    if (len == 0) {
+      co_return std::nullopt;
+    }
+
+    auto leaf = [head, len, bop, proj](std::ptrdiff_t b) mutable -> acc_t {
+      //
+      std::ptrdiff_t lo = b * deterministic_block;
+      std::ptrdiff_t hi = std::min(lo + deterministic_block, len);
+
+      acc_t acc = acc_t(std::invoke(proj, head[lo]));
+
+      for (std::ptrdiff_t i = lo + 1; i < hi; ++i) {
+        acc = std::invoke(bop, std::move(acc), std::invoke(proj, head[i]));
+      }
+
+      return acc;
+    };
+
+    auto combine = [bop](acc_t lhs, acc_t rhs) mutable -> acc_t {
+      return std::invoke(bop, std::move(lhs), std::move(rhs));
+    };
+
+    std::ptrdiff_t blocks = (len + deterministic_block - 1) / deterministic_block;
+
+    eventually<acc_t> acc;
+
+    auto grain = detail::grain_blocks(n);
+
+    co_await lf::call(&acc, detail::block_tree<acc_t>{})(0, blocks, grain, leaf, combine);
+    co_await lf::join;
+
+    co_return *std::move(acc);
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Bop,
+            typename Proj = std::identity>
+    requires deterministically_foldable<Bop, I, Proj>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, I, Proj>>> {
+    std::optional<indirect_fold_acc_t<Bop, I, Proj>> out;
+    co_await lf::call(&out, self)(head, tail, detail::k_deterministic_grain, std::move(bop), std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, typename Bop, typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && deterministically_foldable<Bop, std::ranges::iterator_t<R>, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<R>, Proj>>> {
+    std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<R>, Proj>> out;
+    co_await lf::call(&out, self)(
+        std::ranges::begin(range), std::ranges::end(range), n, std::move(bop), std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, typename Bop, typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && deterministically_foldable<Bop, std::ranges::iterator_t<R>, Proj>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<R>, Proj>>> {
+    std::optional<indirect_fold_acc_t<Bop, std::ranges::iterator_t<R>, Proj>> out;
+    co_await lf::call(&out, self)(std::ranges::begin(range),
+                                  std::ranges::end(range),
+                                  detail::k_deterministic_grain,
+                                  std::move(bop),
+                                  std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::deterministic_sum`.
+ */
+struct deterministic_sum_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Proj = std::identity>
+    requires deterministically_summable<I, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<detail::summand_t<I, Proj>> {
+
+    LF_ASSERT(n > 0);
+
+    using sum_t = detail::compensated<detail::summand_t<I, Proj>>;
+
+    std::ptrdiff_t len = tail - head;
+
+    LF_ASSERT(len >= 0);
+
+    if (len == 0) {
+      co_return 0;
+    }
+
+    auto leaf = [head, len, proj](std::ptrdiff_t b) mutable -> sum_t {
+      //
+      std::ptrdiff_t lo = b * deterministic_block;
+      std::ptrdiff_t hi = std::min(lo + deterministic_block, len);
+
+      sum_t acc;
+
+      for (std::ptrdiff_t i = lo; i < hi; ++i) {
+        acc.add(std::invoke(proj, head[i]));
+      }
+
+      return acc;
+    };
+
+    std::ptrdiff_t blocks = (len + deterministic_block - 1) / deterministic_block;
+
+    sum_t acc;
+
+    auto grain = detail::grain_blocks(n);
+
+    co_await lf::call(&acc, detail::block_tree<sum_t>{})(0, blocks, grain, leaf, std::plus<>{});
+    co_await lf::join;
+
+    co_return acc.value();
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename Proj = std::identity>
+    requires deterministically_summable<I, Proj>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, Proj proj = {})
+      LF_STATIC_CONST->lf::task<detail::summand_t<I, Proj>> {
+    detail::summand_t<I, Proj> out{};
+    co_await lf::call(&out, self)(head, tail, detail::k_deterministic_grain, std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && deterministically_summable<std::ranges::iterator_t<R>, Proj>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<detail::summand_t<std::ranges::iterator_t<R>, Proj>> {
+    detail::summand_t<std::ranges::iterator_t<R>, Proj> out{};
+    co_await lf::call(&out, self)(std::ranges::begin(range), std::ranges::end(range), n, std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && deterministically_summable<std::ranges::iterator_t<R>, Proj>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, Proj proj = {})
+      LF_STATIC_CONST->lf::task<detail::summand_t<std::ranges::iterator_t<R>, Proj>> {
+    detail::summand_t<std::ranges::iterator_t<R>, Proj> out{};
+    co_await lf::call(&out, self)(
+        std::ranges::begin(range), std::ranges::end(range), detail::k_deterministic_grain, std::move(proj));
+    co_await lf::join;
+    co_return out;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel fold with an association order that is independent of the thread count and steals.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Bop,
+ *              typename Proj = std::identity
+ *              >
+ *      requires indirectly_foldable<Bop, projected<I, Proj>>
+ *    auto deterministic_fold(I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {})
+ *        -> std::optional<indirect_fold_acc_t<Bop, I, Proj>>;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``). Returns an empty optional if the range is empty.
+ *
+ * \endrst
+ *
+ * The input is cut into blocks of `lf::deterministic_block` elements, each block is folded left to right
+ * and then the blocks are combined in a balanced binary tree (the first half of the blocks before the
+ * second). This tree depends only on the length of the input. The chunk size ``n`` only selects the
+ * subtrees that are evaluated in parallel, hence the result is the same for any ``n``, any number of
+ * threads and any pattern of steals.
+ *
+ * In contrast, the association order of `lf::fold` is a function of both the length and ``n``.
+ *
+ * The binary operator and projection must be regular (not async) functions. This function will make an
+ * implementation defined number of copies of the function objects and may invoke these copies concurrently.
+ */
+inline constexpr impl::deterministic_fold_overload deterministic_fold = {};
+
+/**
+ * @brief A deterministic and compensated parallel sum of floating point values.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              typename Proj = std::identity,
+ *              typename T = std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>
+ *              >
+ *      requires std::floating_point<T>
+ *    auto deterministic_sum(I head, S tail, std::iter_difference_t<I> n, Proj proj = {}) -> T;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``). Returns zero if the range is empty.
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    double total = co_await just[deterministic_sum](trades, [](trade const &t) { return t.amount; });
+ *
+ * \endrst
+ *
+ * The association order is that of `lf::deterministic_fold`. Each block is summed with Kahan-Babuska
+ * (Neumaier) compensation and the compensation terms are carried up the tree. The error is then
+ * essentially independent of the length of the input and the result is bit-identical across machines.
+ * This assumes IEEE floating point arithmetic without value-unsafe optimizations (e.g. ``-ffast-math``,
+ * which would remove the compensation).
+ */
+inline constexpr impl::deterministic_sum_overload deterministic_sum = {};
+} // namespace lf
+
+#endif /* A7FDBE86_95F4_0F58_39B2_FCF17DEF8171 */
@@ -0,0 +1,345 @@
+#ifndef A7E4C1B8_3D92_4F05_B6A3_58C0E7D2F914
+#define A7E4C1B8_3D92_4F05_B6A3_58C0E7D2F914
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for min
+#include <concepts>    // for regular_invocable, copy_constructible, copyable, assignable_from
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <functional>  // for identity, invoke
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_value_t, iter_reference_t
+#include <optional>    // for optional
+#include <ranges>      // for begin, ssize, iterator_t, random_access_range, sized_range
+#include <type_traits> // for invoke_result_t
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/core/control_flow.hpp"         // for call, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file exclusive_scan.hpp
+ *
+ * @brief A parallel exclusive scan with an initial value.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief The result of projecting an element of `I`.
+ */
+template <class I, class Proj>
+using proj_result_t = std::invoke_result_t<Proj &, std::iter_reference_t<I>>;
+
+/**
+ * @brief Test if `acc = bop(acc, v)` is valid for an `acc` of type `Acc` and a `v` of type `V`.
+ */
+template <class Bop, class Acc, class V>
+concept scan_step =
+    std::regular_invocable<Bop &, Acc, V> && std::assignable_from<Acc &, std::invoke_result_t<Bop &, Acc, V>>;
+
+} // namespace detail
+
+/**
+ * @brief Test if `Bop` and `Proj` are regular (not async) functions that can scan `I` into `O`.
+ *
+ * Unlike ``lf::indirectly_scannable`` the accumulator is always `std::iter_value_t<O>` and `Bop` need only
+ * accept it on the left, this permits e.g. summing `int` lengths into `std::size_t` offsets.
+ */
+template <class Bop, class O, class I, class Proj>
+concept regular_scannable =
+    std::copy_constructible<Bop> &&                                                   //
+    std::copy_constructible<Proj> &&                                                  //
+    std::regular_invocable<Proj &, std::iter_reference_t<I>> &&                       //
+    std::copyable<std::iter_value_t<O>> &&                                            //
+    std::indirectly_writable<O, std::iter_value_t<O> const &> &&                      //
+    std::constructible_from<std::iter_value_t<O>, detail::proj_result_t<I, Proj>> &&  //
+    detail::scan_step<Bop, std::iter_value_t<O>, detail::proj_result_t<I, Proj>> &&   //
+    detail::scan_step<Bop, std::iter_value_t<O>, std::iter_value_t<O>>;
+
+namespace detail {
+
+/**
+ * @brief The chunk size used when `n` is omitted by the block based scans.
+ */
+inline constexpr std::ptrdiff_t k_scan_grain = 4096;
+
+/**
+ * @brief A three pass, block based, exclusive scan.
+ */
+struct exclusive_scan_impl {
+  /**
+   * @brief Reduce each block, scan the block sums serially then rescan each block with its offset.
+   *
+   * Every element is read before its output is written hence `out` may equal `beg`.
+   */
+  template <std::random_access_iterator I, std::random_access_iterator O, class T, class Bop, class Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I beg,
+                                 std::ptrdiff_t len,
+                                 O out,
+                                 T init,
+                                 std::ptrdiff_t n,
+                                 Bop bop,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(len >= 0);
+
+    std::ptrdiff_t chunks = (len + n - 1) / n;
+
+    // `offset[k]` is the exclusive prefix of block `k`, before the serial scan it holds the sum of block
+    // `k - 1`, the last block's sum is never needed.
+
+    std::vector<std::optional<T>> offset(static_cast<std::size_t>(chunks));
+
+    if (chunks > 1) {
+      co_await lf::call(for_leaves{})(0, chunks - 1, [=, &offset](std::ptrdiff_t k) mutable {
+        std::ptrdiff_t i = k * n;
+        std::ptrdiff_t end = i + n;
+
+        T acc(std::invoke(proj, beg[i]));
+
+        for (++i; i < end; ++i) {
+          acc = std::invoke(bop, std::move(acc), std::invoke(proj, beg[i]));
+        }
+
+        offset[static_cast<std::size_t>(k + 1)] = std::move(acc);
+      });
+      co_await lf::join;
+    }
+
+    if (chunks > 0) {
+      offset[0] = std::move(init);
+    }
+
+    for (std::size_t k = 1; k < offset.size(); ++k) {
+      *offset[k] = std::invoke(bop, *offset[k - 1], std::move(*offset[k]));
+    }
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      T acc = std::move(*offset[static_cast<std::size_t>(k)]);
+
+      for (std::ptrdiff_t i = k * n, end = std::min(i + n, len); i < end; ++i) {
+        // Compute the next prefix first, the input may alias the output.
+        auto next = std::invoke(bop, acc, std::invoke(proj, beg[i]));
+        out[i] = std::move(acc);
+        acc = std::move(next);
+      }
+    });
+
+    co_await lf::join;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Eight overloads of exclusive_scan for (iterator/range, chunk/in_place, n = 4096/n != 4096).
+ */
+struct exclusive_scan_overload {
+  /**
+   * @brief [iterator,chunk,output] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, I, Proj> Bop>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I beg,
+                                 S end,
+                                 O out,
+                                 std::iter_value_t<O> init,
+                                 std::iter_difference_t<I> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(beg, end - beg, out, std::move(init), n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,n = 4096,output] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, I, Proj> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I beg, S end, O out, std::iter_value_t<O> init, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(
+        beg, end - beg, out, std::move(init), detail::k_scan_grain, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,chunk,in_place] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            regular_scannable<I, I, Proj> Bop>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I beg,
+                                 S end,
+                                 std::iter_value_t<I> init,
+                                 std::iter_difference_t<I> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(beg, end - beg, beg, std::move(init), n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,n = 4096,in_place] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            class Proj = std::identity,
+            regular_scannable<I, I, Proj> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I beg, S end, std::iter_value_t<I> init, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(
+        beg, end - beg, beg, std::move(init), detail::k_scan_grain, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,chunk,output] version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 O out,
+                                 std::iter_value_t<O> init,
+                                 std::ranges::range_difference_t<R> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(
+        std::ranges::begin(range), std::ranges::ssize(range), out, std::move(init), n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,n = 4096,output] version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, O out, std::iter_value_t<O> init, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(std::ranges::begin(range),
+                                                     std::ranges::ssize(range),
+                                                     out,
+                                                     std::move(init),
+                                                     detail::k_scan_grain,
+                                                     bop,
+                                                     proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,chunk,in_place] version.
+   */
+  template <std::ranges::random_access_range R,
+            class Proj = std::identity,
+            regular_scannable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 std::ranges::range_value_t<R> init,
+                                 std::ranges::range_difference_t<R> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(std::ranges::begin(range),
+                                                     std::ranges::ssize(range),
+                                                     std::ranges::begin(range),
+                                                     std::move(init),
+                                                     n,
+                                                     bop,
+                                                     proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,n = 4096,in_place] version.
+   */
+  template <std::ranges::random_access_range R,
+            class Proj = std::identity,
+            regular_scannable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, std::ranges::range_value_t<R> init, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::exclusive_scan_impl{})(std::ranges::begin(range),
+                                                     std::ranges::ssize(range),
+                                                     std::ranges::begin(range),
+                                                     std::move(init),
+                                                     detail::k_scan_grain,
+                                                     bop,
+                                                     proj);
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel implementation of `std::exclusive_scan` that accepts generalized ranges and projections.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::random_access_iterator O,
+ *              class Proj = std::identity,
+ *              regular_scannable<O, I, Proj> Bop
+ *              >
+ *    void exclusive_scan(I beg, S end, O out, std::iter_value_t<O> init, std::iter_difference_t<I> n,
+ *                        Bop bop, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``), in place scans (omit the
+ * `out` iterator) and, the chunk size, ``n``, can be omitted (which will set ``n = 4096``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[exclusive_scan](record_lengths, 0, std::plus<>{});
+ *
+ * \endrst
+ *
+ * This computes the cumulative sum of the input, excluding the current element, starting from ``init``
+ * and stores it in the output-range e.g. `[1, 2, 2, 1] -> [0, 1, 3, 5]` for ``init = 0``.
+ *
+ * The input and output ranges must either be distinct (i.e. non-overlapping) or the same range, in place
+ * scans need no extra storage beyond one value per chunk.
+ *
+ * The input is split into chunks of ``n`` elements, each chunk is reduced in parallel, the chunk sums are
+ * scanned serially and then each chunk is scanned in parallel. Unlike ``lf::scan`` the binary operator and
+ * projection must be regular (non-async) functions.
+ */
+inline constexpr impl::exclusive_scan_overload exclusive_scan = {};
+
+} // namespace lf
+
+#endif /* A7E4C1B8_3D92_4F05_B6A3_58C0E7D2F914 */
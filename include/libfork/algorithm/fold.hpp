@@ -14,9 +14,10 @@
 #include <iterator>    // for random_access_iterator, sized_sentinel_for
 #include <optional>    // for nullopt, optional
 #include <ranges>      // for begin, end, iterator_t, empty, random_acces...
-#include <type_traits> // for decay_t
+#include <type_traits> // for conditional_t, decay_t
 
 #include "libfork/algorithm/constraints.hpp" // for projected, indirect_fold_acc_t, indirectly_...
+#include "libfork/algorithm/views.hpp"       // for fused_view, fused_projection, skip_empty
 #include "libfork/core/control_flow.hpp"     // for call, fork, join, dispatch
 #include "libfork/core/eventually.hpp"       // for eventually
 #include "libfork/core/just.hpp"             // for just
@@ -153,6 +154,31 @@ struct fold_overload_impl {
   }
 };
 
+/**
+ * @brief The binary operation used to fold a fused pipeline.
+ *
+ * Filters are fused by lifting the operation to skip the empty optionals the projection yields.
+ */
+template <typename Bop, typename V, typename... Stages>
+using fused_bop_t = std::conditional_t<fused_view<V, Stages...>::filtered, skip_empty<Bop>, Bop>;
+
+/**
+ * @brief The accumulator of a fold over a fused pipeline.
+ */
+template <typename Bop, typename V, typename... Stages>
+using fused_acc_t =
+    indirect_fold_acc_t<fused_bop_t<Bop, V, Stages...>, std::ranges::iterator_t<V>, fused_projection<Stages...>>;
+
+/**
+ * @brief The result of a fold over a fused pipeline.
+ *
+ * The accumulator of a filtered fold is already optional.
+ */
+template <typename Bop, typename V, typename... Stages>
+using fused_fold_t = std::conditional_t<fused_view<V, Stages...>::filtered,
+                                        fused_acc_t<Bop, V, Stages...>,
+                                        std::optional<fused_acc_t<Bop, V, Stages...>>>;
+
 } // namespace detail
 
 /**
@@ -259,6 +285,40 @@ struct fold_overload {
         std::ranges::begin(range), std::ranges::end(range), n, std::move(bop), std::move(proj) //
     );
   }
+
+  /**
+   * @brief Fused pipeline version.
+   */
+  template <class V, class... Stages, class Bop>
+    requires indirectly_foldable<detail::fused_bop_t<Bop, V, Stages...>,
+                                 projected<std::ranges::iterator_t<V>, fused_projection<Stages...>>>
+  LF_STATIC_CALL auto operator()(auto fold,
+                                 fused_view<V, Stages...> view,
+                                 std::ranges::range_difference_t<V> n,
+                                 Bop bop) LF_STATIC_CONST->lf::task<detail::fused_fold_t<Bop, V, Stages...>> {
+
+    detail::fused_bop_t<Bop, V, Stages...> op{std::move(bop)};
+
+    auto acc = co_await lf::just(fold)(view.base(), n, std::move(op), view.projection());
+
+    if constexpr (fused_view<V, Stages...>::filtered) {
+      // Empty if the range was empty, engaged but empty if every element was filtered out.
+      co_return acc ? std::move(*acc) : std::nullopt;
+    } else {
+      co_return acc;
+    }
+  }
+
+  /**
+   * @brief Fused pipeline version.
+   */
+  template <class V, class... Stages, class Bop>
+    requires indirectly_foldable<detail::fused_bop_t<Bop, V, Stages...>,
+                                 projected<std::ranges::iterator_t<V>, fused_projection<Stages...>>>
+  LF_STATIC_CALL auto operator()(auto fold, fused_view<V, Stages...> view, Bop bop)
+      LF_STATIC_CONST->lf::task<detail::fused_fold_t<Bop, V, Stages...>> {
+    co_return co_await lf::just(fold)(std::move(view), 1, std::move(bop));
+  }
 };
 
 } // namespace impl
@@ -282,7 +342,9 @@ struct fold_overload {
  *    auto fold(I head, S tail, std::iter_difference_t<I> n, Bop bop, Proj proj = {}) -> indirect_fold_acc_t<Bop, I, Proj>;
  *
  * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
- * (which will set ``n = 1``).
+ * (which will set ``n = 1``). The range may also be a pipeline built with ``lf::views::transform`` and
+ * ``lf::views::filter`` (without a projection), the stages are then applied in the leaves of the fold. A
+ * filtered fold returns an empty optional if no element passes the filters.
  *
  * Exemplary usage:
  *
@@ -296,6 +358,10 @@ struct fold_overload {
  * 
  * This counts the number of even elements in `v` in parallel, using a chunk size of ``10``.
  *
+ * The association order is a function of the length of the range and ``n``, it is independent of the
+ * number of threads. Use `lf::deterministic_fold` or `lf::deterministic_sum` for an order (and hence a
+ * floating point result) that is also independent of ``n``.
+ *
  * If the binary operator or projection handed to `fold` are async functions, then they will be
  * invoked asynchronously, this allows you to launch further tasks recursively.
  *
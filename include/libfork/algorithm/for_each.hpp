@@ -9,15 +9,16 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <functional> // for identity
+#include <functional> // for identity, invoke
 #include <iterator>   // for iter_difference_t, random_access_iterator
 #include <ranges>     // for begin, end, iterator_t, random_access_range
 
-#include "libfork/algorithm/constraints.hpp" // for indirectly_unary_invocable, projected
-#include "libfork/core/control_flow.hpp"     // for call, fork, join
-#include "libfork/core/just.hpp"             // for just
-#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
-#include "libfork/core/task.hpp"             // for task
+#include "libfork/algorithm/constraints.hpp"    // for indirectly_unary_invocable, projected
+#include "libfork/algorithm/impl/sync_leaf.hpp" // for for_each_leaf, sync_projected_invocable
+#include "libfork/core/control_flow.hpp"        // for call, fork, join
+#include "libfork/core/just.hpp"                // for just
+#include "libfork/core/macro.hpp"               // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                // for task
 
 /**
  * @file for_each.hpp
@@ -56,8 +57,12 @@ struct for_each_overload {
     }
 
     if (len <= n) {
-      for (; head != tail; ++head) {
-        co_await lf::just(fun)(co_await just(proj)(*head));
+      if constexpr (detail::sync_projected_invocable<I, Proj, Fun>) {
+        detail::for_each_leaf(head, len, fun, proj);
+      } else {
+        for (; head != tail; ++head) {
+          co_await lf::just(fun)(co_await just(proj)(*head));
+        }
       }
       co_return;
     }
@@ -97,7 +102,11 @@ struct for_each_overload {
       case 0:
         break;
       case 1:
-        co_await lf::just(fun)(co_await just(proj)(*head));
+        if constexpr (detail::sync_projected_invocable<I, Proj, Fun>) {
+          std::invoke(fun, std::invoke(proj, *head));
+        } else {
+          co_await lf::just(fun)(co_await just(proj)(*head));
+        }
         break;
       default:
         auto mid = head + (len / 2);
@@ -190,6 +199,8 @@ struct for_each_overload {
  *
  * If the function or projection handed to `for_each` are async functions, then they will be
  * invoked asynchronously, this allows you to launch further tasks recursively.
+ * If neither is async then each leaf is a plain loop with no suspension points, over raw pointers when
+ * the iterators are contiguous, which the optimizer is free to vectorize.
  *
  * Unlike `std::ranges::for_each`, this function will make an implementation defined number of copies
  * of the function objects and may invoke these copies concurrently.
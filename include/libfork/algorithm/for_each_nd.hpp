@@ -0,0 +1,341 @@
+#ifndef A7E5C0D2_93B1_4F6E_8A2D_C41F7B0E5D38
+#define A7E5C0D2_93B1_4F6E_8A2D_C41F7B0E5D38
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>      // for array
+#include <concepts>   // for invocable, copy_constructible
+#include <cstddef>    // for size_t, ptrdiff_t
+#include <functional> // for invoke
+#include <utility>    // for index_sequence, make_index_sequence, move, as_const
+
+#include "libfork/algorithm/constraints.hpp" // for invocable
+#include "libfork/core/control_flow.hpp"     // for call, fork, join, dispatch
+#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/tag.hpp"              // for tag, eager_throw_outside
+#include "libfork/core/task.hpp"             // for task
+
+/**
+ * @file for_each_nd.hpp
+ *
+ * @brief A parallel loop over multidimensional index spaces.
+ */
+
+namespace lf {
+
+/**
+ * @brief A half-open box of indices, ``[lo[d], hi[d])`` in each dimension ``d``.
+ */
+template <std::size_t N>
+  requires (N > 0)
+struct blocked_range {
+  /**
+   * @brief The first index in each dimension.
+   */
+  std::array<std::ptrdiff_t, N> lo;
+  /**
+   * @brief One past the last index in each dimension.
+   */
+  std::array<std::ptrdiff_t, N> hi;
+
+  /**
+   * @brief The number of indices in dimension `d`.
+   */
+  [[nodiscard]] constexpr auto extent(std::size_t d) const noexcept -> std::ptrdiff_t {
+    return hi[d] - lo[d];
+  }
+
+  /**
+   * @brief Test if the box contains no indices.
+   */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool {
+    for (std::size_t d = 0; d < N; ++d) {
+      if (extent(d) <= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief The number of indices in the box.
+   */
+  [[nodiscard]] constexpr auto size() const noexcept -> std::ptrdiff_t {
+    if (empty()) {
+      return 0;
+    }
+    std::ptrdiff_t prod = 1;
+    for (std::size_t d = 0; d < N; ++d) {
+      prod *= extent(d);
+    }
+    return prod;
+  }
+};
+
+namespace impl {
+
+/**
+ * @brief Test if `Fun` should be handed whole tiles.
+ */
+template <typename Fun, std::size_t N>
+concept tile_invocable = invocable<Fun &, blocked_range<N> const &>;
+
+namespace detail {
+
+template <std::size_t>
+using index_t = std::ptrdiff_t;
+
+template <typename Fun, std::size_t... Is>
+consteval auto invocable_with_indices(std::index_sequence<Is...> /* unused */) -> bool {
+  return invocable<Fun &, index_t<Is>...>;
+}
+
+template <typename Fun, std::size_t... Is>
+consteval auto regular_with_indices(std::index_sequence<Is...> /* unused */) -> bool {
+  return std::invocable<Fun &, index_t<Is>...>;
+}
+
+} // namespace detail
+
+/**
+ * @brief Test if `Fun` should be invoked with `N` indices.
+ */
+template <typename Fun, std::size_t N>
+concept index_invocable = detail::invocable_with_indices<Fun>(std::make_index_sequence<N>{});
+
+/**
+ * @brief Overload set for `lf::for_each_nd`.
+ */
+struct for_each_nd_overload {
+ private:
+  /**
+   * @brief Advance `idx` through `box` in row-major order, returns `false` after the last index.
+   */
+  template <std::size_t N>
+  static constexpr auto
+  next(std::array<std::ptrdiff_t, N> &idx, blocked_range<N> const &box) noexcept -> bool {
+    for (std::size_t d = N; d-- > 0;) {
+      if (++idx[d] < box.hi[d]) {
+        return true;
+      }
+      idx[d] = box.lo[d];
+    }
+    return false;
+  }
+
+ public:
+  /**
+   * @brief Recursively split the dimension with the most tiles.
+   */
+  template <std::size_t N, typename Fun>
+    requires std::copy_constructible<Fun> && (tile_invocable<Fun, N> || index_invocable<Fun, N>)
+  LF_STATIC_CALL auto operator()(auto for_each_nd,
+                                 blocked_range<N> box,
+                                 std::array<std::ptrdiff_t, N> grain,
+                                 Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    if (box.empty()) {
+      co_return;
+    }
+
+    // Find the dimension spanning the most tiles.
+
+    std::size_t split = 0;
+    std::ptrdiff_t most = 0;
+
+    for (std::size_t d = 0; d < N; ++d) {
+
+      LF_ASSERT(grain[d] > 0);
+
+      std::ptrdiff_t tiles = (box.extent(d) + grain[d] - 1) / grain[d];
+
+      if (tiles > most) {
+        most = tiles;
+        split = d;
+      }
+    }
+
+    if (most <= 1) {
+
+      // A single tile, this is the leaf.
+
+      using mod = modifier::eager_throw_outside;
+
+      if constexpr (tile_invocable<Fun, N>) {
+        if constexpr (std::invocable<Fun &, blocked_range<N> const &>) {
+          std::invoke(fun, std::as_const(box));
+        } else {
+          co_await lf::dispatch<tag::call, mod>(fun)(std::as_const(box));
+        }
+      } else {
+
+        std::array<std::ptrdiff_t, N> idx = box.lo;
+
+        constexpr auto seq = std::make_index_sequence<N>{};
+
+        // Invoke `fun` with the unpacked indices, returns an awaitable if `fun` is async.
+        auto invoke = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+          if constexpr (detail::regular_with_indices<Fun>(seq)) {
+            std::invoke(fun, idx[Is]...);
+          } else {
+            return lf::dispatch<tag::call, mod>(fun)(idx[Is]...);
+          }
+        };
+
+        do {
+          if constexpr (detail::regular_with_indices<Fun>(seq)) {
+            invoke(seq);
+          } else {
+            co_await invoke(seq);
+          }
+        } while (next(idx, box));
+      }
+
+      co_return;
+    }
+
+    // Split on a tile boundary so every leaf (except the last in each dimension) is a full tile.
+
+    blocked_range<N> lhs = box;
+    blocked_range<N> rhs = box;
+
+    lhs.hi[split] = rhs.lo[split] = box.lo[split] + (most / 2) * grain[split];
+
+    // clang-format off
+
+    co_await lf::fork(for_each_nd)(lhs, grain, fun);
+
+    LF_TRY {
+      co_await lf::call(for_each_nd)(rhs, grain, fun);
+    } LF_CATCH_ALL {
+      for_each_nd.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Unit grain version.
+   */
+  template <std::size_t N, typename Fun>
+    requires std::copy_constructible<Fun> && (tile_invocable<Fun, N> || index_invocable<Fun, N>)
+  LF_STATIC_CALL auto
+  operator()(auto for_each_nd, blocked_range<N> box, Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    std::array<std::ptrdiff_t, N> grain;
+
+    grain.fill(1);
+
+    co_await lf::call(for_each_nd)(box, grain, std::move(fun));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::for_each_2d`.
+ */
+struct for_each_2d_overload {
+  /**
+   * @brief Tiled version, dispatches to `lf::for_each_nd`.
+   */
+  template <typename Fun>
+    requires std::copy_constructible<Fun> && (tile_invocable<Fun, 2> || index_invocable<Fun, 2>)
+  LF_STATIC_CALL auto operator()(auto,
+                                 std::ptrdiff_t rows,
+                                 std::ptrdiff_t cols,
+                                 std::ptrdiff_t tile_rows,
+                                 std::ptrdiff_t tile_cols,
+                                 Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    blocked_range<2> box{{0, 0}, {rows, cols}};
+
+    co_await lf::call(for_each_nd_overload{})(box, std::array{tile_rows, tile_cols}, std::move(fun));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Unit tile version, dispatches to `lf::for_each_nd`.
+   */
+  template <typename Fun>
+    requires std::copy_constructible<Fun> && (tile_invocable<Fun, 2> || index_invocable<Fun, 2>)
+  LF_STATIC_CALL auto
+  operator()(auto, std::ptrdiff_t rows, std::ptrdiff_t cols, Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    blocked_range<2> box{{0, 0}, {rows, cols}};
+
+    co_await lf::call(for_each_nd_overload{})(box, std::move(fun));
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel loop over an `N`-dimensional box of indices.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::size_t N, typename Fun>
+ *    void for_each_nd(blocked_range<N> box, std::array<std::ptrdiff_t, N> grain, Fun fun);
+ *
+ * The box is recursively halved along the dimension that spans the most ``grain``-sized tiles (splits fall
+ * on tile boundaries) until a single tile remains. If ``fun`` is invocable with a ``blocked_range<N>`` it is
+ * handed the tile, otherwise it is invoked with the ``N`` indices of each element of the tile in row-major
+ * order. The ``grain`` can be omitted (which will set it to ``1`` in every dimension).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await lf::call(for_each_nd)(blocked_range<3>{{0, 0, 0}, {nx, ny, nz}}, {8, 8, 64}, [&](auto tile) {
+ *      // Stencil over the cache-resident tile.
+ *    });
+ *
+ * \endrst
+ *
+ * If the function is an async function, then it will be invoked asynchronously, this allows you to launch
+ * further tasks recursively.
+ *
+ * This will make an implementation defined number of copies of the function object and may invoke these
+ * copies concurrently.
+ */
+inline constexpr impl::for_each_nd_overload for_each_nd = {};
+
+/**
+ * @brief A two dimensional parallel loop over ``[0, rows) x [0, cols)``.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <typename Fun>
+ *    void for_each_2d(std::ptrdiff_t rows,
+ *                     std::ptrdiff_t cols,
+ *                     std::ptrdiff_t tile_rows,
+ *                     std::ptrdiff_t tile_cols,
+ *                     Fun fun);
+ *
+ * This is a shorthand for ``for_each_nd`` with a ``blocked_range<2>``, ``fun`` is either handed a tile or
+ * invoked as ``fun(i, j)``. The tile size can be omitted (which will set it to ``1 x 1``).
+ *
+ * \endrst
+ */
+inline constexpr impl::for_each_2d_overload for_each_2d = {};
+
+} // namespace lf
+
+#endif /* A7E5C0D2_93B1_4F6E_8A2D_C41F7B0E5D38 */
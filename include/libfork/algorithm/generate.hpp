@@ -0,0 +1,567 @@
+#ifndef DFD1135A_905F_4569_8FF0_2C9F3C4822B6
+#define DFD1135A_905F_4569_8FF0_2C9F3C4822B6
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for copy, fill, generate
+#include <concepts>    // for constructible_from, copy_constructible, invocable, same_as
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, indirectly_writable, ...
+#include <memory>      // for allocator, construct_at, destroy, uninitialized_fill
+#include <new>         // for operator new
+#include <ranges>      // for begin, end, ssize, iterator_t, random_access_range, sized_range
+#include <type_traits> // for invoke_result_t, is_lvalue_reference_v, is_trivially_default_constructible_v
+#include <utility>     // for as_const, forward, move
+#include <vector>      // for vector
+
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/core/control_flow.hpp"         // for call, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file generate.hpp
+ *
+ * @brief Parallel initialization: `uninitialized_fill`, `generate`, `iota`, `copy` and `make_first_touch`.
+ *
+ * A page of memory is placed on the NUMA node of the thread that first writes to it. These algorithms
+ * write in the same recursive split as `lf::for_each`, `lf::map` and `lf::fold`. Given the same chunk
+ * size, a range is first-touched in the same pattern as the later parallel passes over it.
+ */
+
+namespace lf {
+
+/**
+ * @brief An allocator that default-initializes (instead of value-initializes) elements.
+ *
+ * A `std::vector<T, default_init_allocator<T>>` of a trivially default constructible `T` does not write to
+ * its memory when it is constructed with a size. This leaves the pages free to be first-touched in parallel.
+ */
+template <typename T>
+struct default_init_allocator : std::allocator<T> {
+  /**
+   * @brief Default constructor.
+   */
+  constexpr default_init_allocator() noexcept = default;
+
+  /**
+   * @brief Rebinding constructor.
+   */
+  template <typename U>
+  constexpr explicit(false) default_init_allocator(default_init_allocator<U> const & /* unused */) noexcept {}
+
+  /**
+   * @brief Default-initialize an element.
+   */
+  template <typename U>
+  constexpr void construct(U *ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+    ::new (static_cast<void *>(ptr)) U;
+  }
+
+  /**
+   * @brief Construct an element from `args...`.
+   */
+  template <typename U, typename... Args>
+  constexpr void construct(U *ptr, Args &&...args) {
+    std::construct_at(ptr, std::forward<Args>(args)...);
+  }
+};
+
+/**
+ * @brief A vector whose elements are not written to by its sized constructor, see `lf::make_first_touch`.
+ */
+template <typename T>
+using first_touch_vector = std::vector<T, default_init_allocator<T>>;
+
+namespace impl {
+
+/**
+ * @brief Test if `I` may be the target of `std::ranges::uninitialized_fill` with a `T`.
+ */
+template <typename I, typename T>
+concept uninitialized_fillable =
+    std::is_lvalue_reference_v<std::iter_reference_t<I>> &&                          //
+    std::same_as<std::remove_cvref_t<std::iter_reference_t<I>>, std::iter_value_t<I>> && //
+    std::constructible_from<std::iter_value_t<I>, T const &>;
+
+/**
+ * @brief Test if `F` is a regular (not async) generator whose results can be written to `I`.
+ */
+template <typename I, typename F>
+concept generator_for = std::copy_constructible<F> &&                                  //
+                        std::invocable<F &> &&                                         //
+                        std::indirectly_writable<I, std::invoke_result_t<F &>>;
+
+/**
+ * @brief Test if `value + i` (for an offset `i`) can be written to `I`, as in `std::ranges::iota`.
+ */
+template <typename I, typename T>
+concept iota_writable = std::weakly_incrementable<T> &&          //
+                        std::copyable<T> &&                      //
+                        std::indirectly_writable<I, T const &> && //
+                        requires (T const value, std::iter_difference_t<T> i) {
+                          { value + i } -> std::convertible_to<T>;
+                        };
+
+/**
+ * @brief Test if `T` may be the element type of a `lf::first_touch_vector`.
+ */
+template <typename T>
+concept first_touchable = std::is_trivially_default_constructible_v<T> && std::copyable<T>;
+
+namespace detail {
+
+/**
+ * @brief The default chunk size of the initialization algorithms.
+ */
+inline constexpr std::ptrdiff_t k_touch_grain = 16 * 1024;
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::uninitialized_fill`.
+ */
+struct uninitialized_fill_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T>
+    requires uninitialized_fillable<I, T>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, T value)
+      LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+
+    // A leaf that throws destroys its own elements, the other leaves are destroyed by `for_leaves`.
+    auto leaf = [head, value](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      std::ranges::uninitialized_fill(head + lo, head + hi, value);
+    };
+
+    auto undo = [head](std::ptrdiff_t lo, std::ptrdiff_t hi) noexcept {
+      std::ranges::destroy(head + lo, head + hi);
+    };
+
+    co_await lf::call(for_leaves{})(0, tail - head, n, leaf, undo);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T>
+    requires uninitialized_fillable<I, T>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, T value) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(head, tail, detail::k_touch_grain, std::move(value));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, typename T>
+    requires std::ranges::sized_range<R> && uninitialized_fillable<std::ranges::iterator_t<R>, T>
+  LF_STATIC_CALL auto
+  operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, T value)
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), n, std::move(value));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, typename T>
+    requires std::ranges::sized_range<R> && uninitialized_fillable<std::ranges::iterator_t<R>, T>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, T value) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(
+        std::ranges::begin(range), std::ranges::end(range), detail::k_touch_grain, std::move(value));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::generate`.
+ */
+struct generate_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename F>
+    requires generator_for<I, F>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, F gen)
+      LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+
+    auto leaf = [head, gen](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      std::ranges::generate(head + lo, head + hi, gen);
+    };
+
+    co_await lf::call(for_leaves{})(0, tail - head, n, leaf);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename F>
+    requires generator_for<I, F>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, F gen) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(head, tail, detail::k_touch_grain, std::move(gen));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R> && generator_for<std::ranges::iterator_t<R>, F>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, F gen)
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), n, std::move(gen));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, typename F>
+    requires std::ranges::sized_range<R> && generator_for<std::ranges::iterator_t<R>, F>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, F gen) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(
+        std::ranges::begin(range), std::ranges::end(range), detail::k_touch_grain, std::move(gen));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::iota`.
+ */
+struct iota_overload {
+  /**
+   * @brief Iterator version, each leaf computes its first value as `value + lo` and then increments.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T>
+    requires iota_writable<I, T>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, T value)
+      LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+
+    auto leaf = [head, value](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      T val = static_cast<T>(value + static_cast<std::iter_difference_t<T>>(lo));
+      for (std::ptrdiff_t i = lo; i < hi; ++i, ++val) {
+        head[i] = std::as_const(val);
+      }
+    };
+
+    co_await lf::call(for_leaves{})(0, tail - head, n, leaf);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T>
+    requires iota_writable<I, T>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, T value) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(head, tail, detail::k_touch_grain, std::move(value));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, typename T>
+    requires std::ranges::sized_range<R> && iota_writable<std::ranges::iterator_t<R>, T>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, T value)
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), n, std::move(value));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, typename T>
+    requires std::ranges::sized_range<R> && iota_writable<std::ranges::iterator_t<R>, T>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, T value) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(
+        std::ranges::begin(range), std::ranges::end(range), detail::k_touch_grain, std::move(value));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::copy`.
+ */
+struct copy_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O>
+    requires std::indirectly_copyable<I, O>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, S tail, O out, std::iter_difference_t<I> n)
+      LF_STATIC_CONST->lf::task<O> {
+
+    LF_ASSERT(n > 0);
+
+    std::ptrdiff_t len = tail - head;
+
+    auto leaf = [head, out](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      std::ranges::copy(head + lo, head + hi, out + lo);
+    };
+
+    co_await lf::call(for_leaves{})(0, len, n, leaf);
+    co_await lf::join;
+
+    co_return out + len;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O>
+    requires std::indirectly_copyable<I, O>
+  LF_STATIC_CALL auto operator()(auto self, I head, S tail, O out) LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(head, tail, out, detail::k_touch_grain);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator O>
+    requires std::ranges::sized_range<R> && std::indirectly_copyable<std::ranges::iterator_t<R>, O>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, O out, std::ranges::range_difference_t<R> n)
+      LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(std::ranges::begin(range), std::ranges::end(range), out, n);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R, std::random_access_iterator O>
+    requires std::ranges::sized_range<R> && std::indirectly_copyable<std::ranges::iterator_t<R>, O>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, O out) LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(
+        std::ranges::begin(range), std::ranges::end(range), out, detail::k_touch_grain);
+    co_await lf::join;
+    co_return end;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::make_first_touch`.
+ */
+struct make_first_touch_overload {
+  /**
+   * @brief Fill version.
+   */
+  template <first_touchable T>
+    requires (!std::invocable<T &>)
+  LF_STATIC_CALL auto operator()(auto /* unused */, std::size_t count, std::ptrdiff_t n, T value)
+      LF_STATIC_CONST->lf::task<first_touch_vector<T>> {
+
+    LF_ASSERT(n > 0);
+
+    first_touch_vector<T> out(count);
+
+    auto leaf = [&out, value](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      std::ranges::fill(out.begin() + lo, out.begin() + hi, value);
+    };
+
+    co_await lf::call(for_leaves{})(0, std::ssize(out), n, leaf);
+    co_await lf::join;
+
+    co_return out;
+  }
+
+  /**
+   * @brief Generator version.
+   */
+  template <std::copy_constructible F, first_touchable T = std::remove_cvref_t<std::invoke_result_t<F &>>>
+    requires std::invocable<F &>
+  LF_STATIC_CALL auto operator()(auto /* unused */, std::size_t count, std::ptrdiff_t n, F gen)
+      LF_STATIC_CONST->lf::task<first_touch_vector<T>> {
+
+    LF_ASSERT(n > 0);
+
+    first_touch_vector<T> out(count);
+
+    auto leaf = [&out, gen](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+      std::ranges::generate(out.begin() + lo, out.begin() + hi, gen);
+    };
+
+    co_await lf::call(for_leaves{})(0, std::ssize(out), n, leaf);
+    co_await lf::join;
+
+    co_return out;
+  }
+
+  /**
+   * @brief Default chunk size fill version.
+   */
+  template <first_touchable T>
+    requires (!std::invocable<T &>)
+  LF_STATIC_CALL auto operator()(auto self, std::size_t count, T value)
+      LF_STATIC_CONST->lf::task<first_touch_vector<T>> {
+    first_touch_vector<T> out;
+    co_await lf::call(&out, self)(count, detail::k_touch_grain, std::move(value));
+    co_await lf::join;
+    co_return out;
+  }
+
+  /**
+   * @brief Default chunk size generator version.
+   */
+  template <std::copy_constructible F, first_touchable T = std::remove_cvref_t<std::invoke_result_t<F &>>>
+    requires std::invocable<F &>
+  LF_STATIC_CALL auto operator()(auto self, std::size_t count, F gen)
+      LF_STATIC_CONST->lf::task<first_touch_vector<T>> {
+    first_touch_vector<T> out;
+    co_await lf::call(&out, self)(count, detail::k_touch_grain, std::move(gen));
+    co_await lf::join;
+    co_return out;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel implementation of `std::ranges::uninitialized_fill`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I, std::sized_sentinel_for<I> S, typename T>
+ *      requires uninitialized_fillable<I, T>
+ *    void uninitialized_fill(I head, S tail, std::iter_difference_t<I> n, T value);
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``).
+ *
+ * \endrst
+ *
+ * The range is split recursively (exactly as `lf::for_each` splits it) into leaves of at most ``n``
+ * elements, each leaf is filled sequentially. If a construction throws then every element constructed (by
+ * any leaf) is destroyed before the exception propagates.
+ */
+inline constexpr impl::uninitialized_fill_overload uninitialized_fill = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::generate`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::copy_constructible F>
+ *      requires std::invocable<F &> && std::indirectly_writable<I, std::invoke_result_t<F &>>
+ *    void generate(I head, S tail, std::iter_difference_t<I> n, F gen);
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``).
+ *
+ * \endrst
+ *
+ * The generator must be a regular (not async) function. Each leaf invokes its own copy of ``gen``, hence a
+ * stateful generator restarts from its initial state at the start of every leaf.
+ */
+inline constexpr impl::generate_overload generate = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::iota`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::weakly_incrementable T>
+ *      requires std::indirectly_writable<I, T const &>
+ *    void iota(I head, S tail, std::iter_difference_t<I> n, T value);
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``).
+ *
+ * \endrst
+ *
+ * Additionally, ``value + i`` must be convertible to ``T`` for an ``i`` of type
+ * ``std::iter_difference_t<T>``, this is used to compute the first value of each leaf.
+ */
+inline constexpr impl::iota_overload iota = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::copy`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I, std::sized_sentinel_for<I> S, std::random_access_iterator O>
+ *      requires std::indirectly_copyable<I, O>
+ *    auto copy(I head, S tail, O out, std::iter_difference_t<I> n) -> O;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16 * 1024``). Returns the end of the output.
+ *
+ * \endrst
+ *
+ * The input and output must not overlap.
+ */
+inline constexpr impl::copy_overload copy = {};
+
+/**
+ * @brief Allocate a `lf::first_touch_vector` and initialize it in parallel.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <typename T>
+ *      requires std::is_trivially_default_constructible_v<T> && std::copyable<T>
+ *    auto make_first_touch(std::size_t count, std::ptrdiff_t n, T value) -> first_touch_vector<T>;
+ *
+ * If the last argument is a nullary function, then the elements are generated (as in ``lf::generate``)
+ * and ``T`` is the type it returns. ``n`` can be omitted (which will set ``n = 16 * 1024``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    lf::first_touch_vector<double> v = co_await just[make_first_touch](1 << 28, 4096, 0.0);
+ *
+ *    co_await just[for_each](v, 4096, [](double &x) { x += 1; });
+ *
+ * \endrst
+ *
+ * The vector's memory is not written to until it is initialized, in parallel and in the split used by
+ * `lf::for_each`. On a NUMA machine each page lands on the node of the worker that first-touched it.
+ * A later pass with the same ``n`` on a pool that keeps its workers on fixed nodes (e.g.
+ * `numa_strategy::seq`) then mostly reads local memory.
+ */
+inline constexpr impl::make_first_touch_overload make_first_touch = {};
+
+} // namespace lf
+
+#endif /* DFD1135A_905F_4569_8FF0_2C9F3C4822B6 */
@@ -0,0 +1,397 @@
+#ifndef F2C7A4D9_8B1E_4F63_A5D0_1E9B7C3A6F48
+#define F2C7A4D9_8B1E_4F63_A5D0_1E9B7C3A6F48
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for fill
+#include <concepts>    // for copy_constructible, regular_invocable, integral, copyable, assignable_from
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <functional>  // for identity, invoke, plus
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_reference_t
+#include <ranges>      // for begin, end, size, random_access_range, sized_range, range_value_t
+#include <type_traits> // for invoke_result_t, remove_cvref_t
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/core/control_flow.hpp" // for call, fork, join
+#include "libfork/core/ext/context.hpp"  // for worker_context
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file histogram.hpp
+ *
+ * @brief Parallel histograms and dense group-by-key reductions.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief Test if `Proj` maps the elements of `I` to an integral bin index.
+ */
+template <typename Proj, typename I>
+concept bin_projection =
+    std::copy_constructible<Proj> &&                            //
+    std::regular_invocable<Proj &, std::iter_reference_t<I>> && //
+    std::integral<std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>>;
+
+/**
+ * @brief Test if `Bop` can fold values of type `V` into, and merge, bins of type `Acc`.
+ */
+template <typename Bop, typename Acc, typename V>
+concept bin_reducer = std::copy_constructible<Bop> &&                                     //
+                      std::copyable<Acc> &&                                               //
+                      std::regular_invocable<Bop &, Acc, V> &&                            //
+                      std::regular_invocable<Bop &, Acc, Acc> &&                          //
+                      std::assignable_from<Acc &, std::invoke_result_t<Bop &, Acc, V>> && //
+                      std::assignable_from<Acc &, std::invoke_result_t<Bop &, Acc, Acc>>;
+
+/**
+ * @brief Test if `Val` and `Bop` can reduce the elements of `I` into bins of type `Acc`.
+ */
+template <typename Bop, typename Val, typename Acc, typename I>
+concept by_key_reducible = std::copy_constructible<Val> &&                            //
+                           std::regular_invocable<Val &, std::iter_reference_t<I>> && //
+                           bin_reducer<Bop, Acc, std::invoke_result_t<Val &, std::iter_reference_t<I>>>;
+
+namespace detail {
+
+/**
+ * @brief The chunk size used when `n` is omitted.
+ */
+inline constexpr std::ptrdiff_t k_histogram_grain = 16 * 1024;
+
+/**
+ * @brief The value of every element when counting.
+ */
+template <std::integral C>
+struct count_one {
+  /**
+   * @brief Ignores its argument.
+   */
+  LF_STATIC_CALL constexpr auto operator()(auto const & /* unused */) LF_STATIC_CONST noexcept -> C {
+    return C{1};
+  }
+};
+
+/**
+ * @brief Reduce `[head, head + len)` into `bins`.
+ *
+ * Leaves fold directly into the bins they are given (so there are no atomics in the inner loop). At a split
+ * the left half is forked into the caller's bins, if the continuation is not stolen then the left half has
+ * finished and the right half folds into the same bins. Only a stolen continuation (running concurrently
+ * with the left half) allocates a set of private, identity initialized, bins which are merged at the join.
+ */
+struct histogram_node {
+  /**
+   * @brief Reduce both halves in parallel, private bins are only allocated if the right half is stolen.
+   *
+   * The merge is serial, it costs `nbins` applications of `bop` per steal.
+   */
+  template <std::random_access_iterator I,
+            std::random_access_iterator O,
+            typename Acc,
+            typename Bop,
+            typename Key,
+            typename Val>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 I head,
+                                 std::ptrdiff_t len,
+                                 O bins,
+                                 std::ptrdiff_t nbins,
+                                 std::ptrdiff_t n,
+                                 Acc identity,
+                                 Bop bop,
+                                 Key key,
+                                 Val val) LF_STATIC_CONST->lf::task<> {
+
+    if (len <= n) {
+      for (std::ptrdiff_t i = 0; i < len; ++i) {
+
+        auto k = static_cast<std::ptrdiff_t>(std::invoke(key, head[i]));
+
+        LF_ASSERT(0 <= k && k < nbins);
+
+        auto &&bin = bins[k];
+        bin = std::invoke(bop, std::move(bin), std::invoke(val, head[i]));
+      }
+      co_return;
+    }
+
+    std::ptrdiff_t mid = len / 2;
+
+    worker_context *owner = self.context();
+
+    std::vector<Acc> tmp;
+
+    // clang-format off
+
+    co_await lf::fork(self)(head, mid, bins, nbins, n, identity, bop, key, val);
+
+    LF_TRY {
+      if (self.context() == owner) {
+        // Not stolen, the left half has finished.
+        co_await lf::call(self)(head + mid, len - mid, bins, nbins, n, identity, bop, key, val);
+      } else {
+        tmp.assign(static_cast<std::size_t>(nbins), identity);
+        co_await lf::call(self)(head + mid, len - mid, tmp.begin(), nbins, n, identity, bop, key, val);
+      }
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    if (!tmp.empty()) {
+      for (std::ptrdiff_t k = 0; k < nbins; ++k) {
+        auto &&bin = bins[k];
+        bin = std::invoke(bop, std::move(bin), std::move(tmp[static_cast<std::size_t>(k)]));
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::reduce_by_key`.
+ */
+struct reduce_by_key_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::ranges::random_access_range B,
+            typename Bop,
+            bin_projection<I> Key,
+            typename Val = std::identity>
+    requires std::ranges::sized_range<B> && by_key_reducible<Bop, Val, std::ranges::range_value_t<B>, I>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 S tail,
+                                 B &&bins,
+                                 std::iter_difference_t<I> n,
+                                 std::ranges::range_value_t<B> identity,
+                                 Bop bop,
+                                 Key key,
+                                 Val val = {}) LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(tail - head >= 0);
+
+    co_await lf::call(detail::histogram_node{})(head,
+                                                static_cast<std::ptrdiff_t>(tail - head),
+                                                std::ranges::begin(bins),
+                                                static_cast<std::ptrdiff_t>(std::ranges::size(bins)),
+                                                static_cast<std::ptrdiff_t>(n),
+                                                std::move(identity),
+                                                std::move(bop),
+                                                std::move(key),
+                                                std::move(val));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            std::ranges::random_access_range B,
+            typename Bop,
+            bin_projection<std::ranges::iterator_t<R>> Key,
+            typename Val = std::identity>
+    requires std::ranges::sized_range<R> && std::ranges::sized_range<B> &&
+             by_key_reducible<Bop, Val, std::ranges::range_value_t<B>, std::ranges::iterator_t<R>>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R &&range,
+                                 B &&bins,
+                                 std::ranges::range_difference_t<R> n,
+                                 std::ranges::range_value_t<B> identity,
+                                 Bop bop,
+                                 Key key,
+                                 Val val = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range),
+                            std::ranges::end(range),
+                            bins,
+                            n,
+                            std::move(identity),
+                            std::move(bop),
+                            std::move(key),
+                            std::move(val));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::histogram`.
+ */
+struct histogram_overload {
+  /**
+   * @brief Iterator version, zeroes the bins and counts into them.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::ranges::random_access_range B,
+            bin_projection<I> Key = std::identity>
+    requires std::ranges::sized_range<B> && std::integral<std::ranges::range_value_t<B>>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, B &&bins, std::iter_difference_t<I> n, Key key = {})
+      LF_STATIC_CONST->lf::task<> {
+
+    using count_t = std::ranges::range_value_t<B>;
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(tail - head >= 0);
+
+    std::ranges::fill(bins, count_t{0});
+
+    co_await lf::call(detail::histogram_node{})(head,
+                                                static_cast<std::ptrdiff_t>(tail - head),
+                                                std::ranges::begin(bins),
+                                                static_cast<std::ptrdiff_t>(std::ranges::size(bins)),
+                                                static_cast<std::ptrdiff_t>(n),
+                                                count_t{0},
+                                                std::plus<>{},
+                                                std::move(key),
+                                                detail::count_one<count_t>{});
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::ranges::random_access_range B,
+            bin_projection<I> Key = std::identity>
+    requires std::ranges::sized_range<B> && std::integral<std::ranges::range_value_t<B>>
+  LF_STATIC_CALL auto
+  operator()(auto self, I head, S tail, B &&bins, Key key = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(head, tail, bins, detail::k_histogram_grain, std::move(key));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            std::ranges::random_access_range B,
+            bin_projection<std::ranges::iterator_t<R>> Key = std::identity>
+    requires std::ranges::sized_range<R> && std::ranges::sized_range<B> &&
+             std::integral<std::ranges::range_value_t<B>>
+  LF_STATIC_CALL auto
+  operator()(auto self, R &&range, B &&bins, std::ranges::range_difference_t<R> n, Key key = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), bins, n, std::move(key));
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            std::ranges::random_access_range B,
+            bin_projection<std::ranges::iterator_t<R>> Key = std::identity>
+    requires std::ranges::sized_range<R> && std::ranges::sized_range<B> &&
+             std::integral<std::ranges::range_value_t<B>>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, B &&bins, Key key = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(
+        std::ranges::begin(range), std::ranges::end(range), bins, detail::k_histogram_grain, std::move(key));
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel reduction of the elements of a range into a dense set of bins, grouped by key.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::ranges::random_access_range B,
+ *              class Bop,
+ *              bin_projection<I> Key,
+ *              class Val = std::identity
+ *              >
+ *      requires by_key_reducible<Bop, Val, std::ranges::range_value_t<B>, I>
+ *    void reduce_by_key(I head, S tail, B &&bins, std::iter_difference_t<I> n,
+ *                       std::ranges::range_value_t<B> identity, Bop bop, Key key, Val val = {});
+ *
+ * An overload exists for a random-access range (instead of ``head`` and ``tail``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::vector<double> totals(num_customers, 0.0);
+ *
+ *    co_await just[reduce_by_key](orders, totals, 4096, 0.0, std::plus<>{}, &order::customer, &order::price);
+ *
+ * \endrst
+ *
+ * For every element ``e`` this computes ``bins[key(e)] = bop(bins[key(e)], val(e))``, ``key`` must return
+ * an index in ``[0, size(bins))``. The existing contents of ``bins`` are the initial values and, as long as
+ * ``bop`` is associative and ``identity`` is its identity, the result is as-if the elements were folded in
+ * order.
+ *
+ * Unlike ``lf::fold`` the accumulator is not copied at each split. Leaves of ``n`` elements fold directly
+ * into a set of bins, a worker folds into the caller's bins until a thief steals part of the range, only
+ * then does the thief allocate a private set of bins (on the heap) which is merged once both halves have
+ * joined. The merges cost ``size(bins)`` operations per steal, not per split.
+ */
+inline constexpr impl::reduce_by_key_overload reduce_by_key = {};
+
+/**
+ * @brief A parallel histogram, count the number of elements in each bin.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::ranges::random_access_range B,
+ *              bin_projection<I> Key = std::identity
+ *              >
+ *      requires std::integral<std::ranges::range_value_t<B>>
+ *    void histogram(I head, S tail, B &&bins, std::iter_difference_t<I> n, Key key = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16384``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::array<long, 256> counts;
+ *
+ *    co_await just[histogram](bytes, counts);
+ *
+ * \endrst
+ *
+ * Overwrites ``bins[k]`` with the number of elements ``e`` for which ``key(e) == k``, ``key`` must return an
+ * index in ``[0, size(bins))``. This is ``lf::reduce_by_key`` with ``std::plus`` and a value of one.
+ */
+inline constexpr impl::histogram_overload histogram = {};
+
+} // namespace lf
+
+#endif /* F2C7A4D9_8B1E_4F63_A5D0_1E9B7C3A6F48 */
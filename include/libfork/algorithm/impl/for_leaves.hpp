@@ -0,0 +1,148 @@
+#ifndef C5E2A9F4_1B7D_4E36_8C0A_93F6D2B4E718
+#define C5E2A9F4_1B7D_4E36_8C0A_93F6D2B4E718
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>   // for invocable, copy_constructible
+#include <cstddef>    // for ptrdiff_t
+#include <functional> // for invoke
+#include <utility>    // for move
+
+#include "libfork/core/control_flow.hpp" // for call, fork, join
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY, ...
+#include "libfork/core/task.hpp"         // for task
+
+/**
+ * @file for_leaves.hpp
+ *
+ * @brief A fork tree over an index range, the skeleton of the multi-pass and initialization algorithms.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief Run `fun` on the leaves of a recursive split of an index range, in parallel.
+ *
+ * Algorithms that partition their input into blocks (and then e.g. scan the per-block results) use this
+ * to run each pass, `fun` is a regular function that typically captures the algorithm's state by reference.
+ */
+struct for_leaves {
+  /**
+   * @brief Halve `[lo, hi)` until a leaf holds at most `n` indices then invoke `fun(leaf_lo, leaf_hi)`.
+   *
+   * This is the split used by `lf::for_each` hence, given the same chunk size, the leaves line up.
+   */
+  template <std::copy_constructible Fun>
+    requires std::invocable<Fun &, std::ptrdiff_t, std::ptrdiff_t>
+  LF_STATIC_CALL auto operator()(auto self, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t n, Fun fun)
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(lo <= hi);
+
+    if (hi - lo <= n) {
+      if (lo != hi) {
+        std::invoke(fun, lo, hi);
+      }
+      co_return;
+    }
+
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+
+    // clang-format off
+
+    co_await lf::fork(self)(lo, mid, n, fun);
+
+    LF_TRY {
+      co_await lf::call(self)(mid, hi, n, fun);
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+
+  /**
+   * @brief As above but, if a leaf throws, `undo(leaf_lo, leaf_hi)` is invoked on the leaves that completed.
+   *
+   * If every leaf is all-or-nothing this rolls back the whole range before the exception propagates. A
+   * subtree is only undone after all of its leaves have completed, `undo` must not throw.
+   */
+  template <std::copy_constructible Fun, std::copy_constructible Undo>
+    requires std::invocable<Fun &, std::ptrdiff_t, std::ptrdiff_t> &&
+             std::invocable<Undo &, std::ptrdiff_t, std::ptrdiff_t>
+  LF_STATIC_CALL auto
+  operator()(auto self, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t n, Fun fun, Undo undo)
+      LF_STATIC_CONST->lf::task<bool> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(lo <= hi);
+
+    if (hi - lo <= n) {
+      if (lo != hi) {
+        std::invoke(fun, lo, hi);
+      }
+      co_return true;
+    }
+
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+
+    // Only written if the subtree completed.
+    bool left = false;
+    bool right = false;
+
+    // clang-format off
+
+    co_await lf::fork(&left, self)(lo, mid, n, fun, undo);
+
+    LF_TRY {
+      co_await lf::call(&right, self)(mid, hi, n, fun, undo);
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    LF_TRY {
+      co_await lf::join;
+    } LF_CATCH_ALL {
+      if (left) {
+        std::invoke(undo, lo, mid);
+      }
+      if (right) {
+        std::invoke(undo, mid, hi);
+      }
+      LF_RETHROW;
+    }
+
+    // clang-format on
+
+    co_return true;
+  }
+
+  /**
+   * @brief Invoke `fun(k)` for every block `k` in `[lo, hi)`.
+   */
+  template <std::copy_constructible Fun>
+    requires std::invocable<Fun &, std::ptrdiff_t>
+  LF_STATIC_CALL auto
+  operator()(auto self, std::ptrdiff_t lo, std::ptrdiff_t hi, Fun fun) LF_STATIC_CONST->lf::task<> {
+
+    auto leaf = [fun](std::ptrdiff_t k, std::ptrdiff_t /* unused */) mutable {
+      std::invoke(fun, k);
+    };
+
+    co_await lf::call(self)(lo, hi, std::ptrdiff_t{1}, std::move(leaf));
+    co_await lf::join;
+  }
+};
+
+} // namespace lf::impl
+
+#endif /* C5E2A9F4_1B7D_4E36_8C0A_93F6D2B4E718 */
@@ -0,0 +1,79 @@
+#ifndef DED2C2E2_618F_424F_A3A1_09E0AC7265D8
+#define DED2C2E2_618F_424F_A3A1_09E0AC7265D8
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>    // for invocable
+#include <functional>  // for invoke
+#include <iterator>    // for contiguous_iterator, iter_difference_t, iter_reference_t
+#include <memory>      // for to_address
+#include <type_traits> // for invoke_result_t
+
+/**
+ * @file sync_leaf.hpp
+ *
+ * @brief Await-free leaf loops, used by the element-wise algorithms when nothing is async.
+ */
+
+namespace lf::impl::detail {
+
+/**
+ * @brief Test if `Proj` and then `Fun` are regular (not async) functions of the elements of `I`.
+ */
+template <typename I, typename Proj, typename Fun>
+concept sync_projected_invocable =
+    std::invocable<Proj &, std::iter_reference_t<I>> &&
+    std::invocable<Fun &, std::invoke_result_t<Proj &, std::iter_reference_t<I>>>;
+
+/**
+ * @brief Lower a contiguous iterator to a raw pointer, other iterators are returned unchanged.
+ *
+ * A loop over a pointer with an integer trip count is the form optimizers vectorize most reliably.
+ */
+template <std::random_access_iterator I>
+constexpr auto lower(I iter) noexcept {
+  if constexpr (std::contiguous_iterator<I>) {
+    return std::to_address(iter);
+  } else {
+    return iter;
+  }
+}
+
+/**
+ * @brief Invoke `fun(proj(head[i]))` for `i` in `[0, len)` with no suspension points.
+ */
+template <std::random_access_iterator I, typename Fun, typename Proj>
+  requires sync_projected_invocable<I, Proj, Fun>
+constexpr void for_each_leaf(I head, std::iter_difference_t<I> len, Fun &fun, Proj &proj) {
+
+  auto first = lower(head);
+
+  for (std::iter_difference_t<I> i = 0; i < len; ++i) {
+    std::invoke(fun, std::invoke(proj, first[i]));
+  }
+}
+
+/**
+ * @brief Assign `out[i] = fun(proj(head[i]))` for `i` in `[0, len)` with no suspension points.
+ */
+template <std::random_access_iterator I, std::random_access_iterator O, typename Fun, typename Proj>
+  requires sync_projected_invocable<I, Proj, Fun>
+constexpr void map_leaf(I head, std::iter_difference_t<I> len, O out, Fun &fun, Proj &proj) {
+
+  auto first = lower(head);
+  auto dest = lower(out);
+
+  for (std::iter_difference_t<I> i = 0; i < len; ++i) {
+    dest[i] = std::invoke(fun, std::invoke(proj, first[i]));
+  }
+}
+
+} // namespace lf::impl::detail
+
+#endif /* DED2C2E2_618F_424F_A3A1_09E0AC7265D8 */
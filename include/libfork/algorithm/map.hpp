@@ -9,15 +9,16 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <functional> // for identity
+#include <functional> // for identity, invoke
 #include <iterator>   // for random_access_iterator, indirectly_copyable
 #include <ranges>     // for iterator_t, begin, end, random_access_range
 
-#include "libfork/algorithm/constraints.hpp" // for projected, indirectly_unary_invocable
-#include "libfork/core/control_flow.hpp"     // for call, fork, join
-#include "libfork/core/just.hpp"             // for just
-#include "libfork/core/macro.hpp"            // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
-#include "libfork/core/task.hpp"             // for task
+#include "libfork/algorithm/constraints.hpp"    // for projected, indirectly_unary_invocable
+#include "libfork/algorithm/impl/sync_leaf.hpp" // for map_leaf, sync_projected_invocable
+#include "libfork/core/control_flow.hpp"        // for call, fork, join
+#include "libfork/core/just.hpp"                // for just
+#include "libfork/core/macro.hpp"               // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                // for task
 
 /**
  * @file map.hpp
@@ -57,8 +58,12 @@ struct map_overload {
     }
 
     if (len <= n) {
-      for (; head != tail; ++head, ++out) {
-        *out = co_await lf::just(fun)(co_await just(proj)(*head));
+      if constexpr (detail::sync_projected_invocable<I, Proj, Fun>) {
+        detail::map_leaf(head, len, out, fun, proj);
+      } else {
+        for (; head != tail; ++head, ++out) {
+          *out = co_await lf::just(fun)(co_await just(proj)(*head));
+        }
       }
       co_return;
     }
@@ -101,7 +106,11 @@ struct map_overload {
       case 0:
         break;
       case 1:
-        *out = co_await lf::just(fun)(co_await just(proj)(*head));
+        if constexpr (detail::sync_projected_invocable<I, Proj, Fun>) {
+          *out = std::invoke(fun, std::invoke(proj, *head));
+        } else {
+          *out = co_await lf::just(fun)(co_await just(proj)(*head));
+        }
         break;
       default:
         auto dif = (len / 2);
@@ -210,6 +219,8 @@ struct map_overload {
  *
  * If the function or projection handed to `map` are async functions, then they will be
  * invoked asynchronously, this allows you to launch further tasks recursively.
+ * If neither is async then each leaf is a plain loop with no suspension points, over raw pointers when
+ * the iterators are contiguous, which the optimizer is free to vectorize.
  *
  * Unlike `std::transform`, this function will make an implementation defined number of copies
  * of the function objects and may invoke these copies concurrently.
@@ -0,0 +1,667 @@
+#ifndef E3A1D7C9_6F2B_4B58_9E14_7C0D5A82F3B6
+#define E3A1D7C9_6F2B_4B58_9E14_7C0D5A82F3B6
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>  // for max, min, merge, set_union, set_intersection, set_difference
+#include <concepts>   // for copy_constructible
+#include <cstddef>    // for ptrdiff_t
+#include <functional> // for identity, invoke, ranges::less, ranges::equal_to
+#include <iterator>   // for random_access_iterator, sized_sentinel_for, mergeable, indirectly_copyable
+#include <numeric>    // for partial_sum
+#include <ranges>     // for begin, end, iterator_t, random_access_range, sized_range
+#include <utility>    // for forward, pair
+#include <vector>     // for vector
+
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/core/control_flow.hpp"         // for call, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file merge.hpp
+ *
+ * @brief Parallel merging, set operations and de-duplication of sorted ranges.
+ */
+
+namespace lf {
+
+namespace impl {
+
+namespace detail {
+
+/**
+ * @brief The chunk size used when `n` is omitted.
+ *
+ * Every chunk costs two binary searches (and a counter for the set operations), so unit chunks are a poor
+ * default.
+ */
+inline constexpr std::ptrdiff_t k_merge_grain = 4096;
+
+/**
+ * @brief An output iterator that discards its writes and counts them.
+ */
+struct counting_sink {
+  /**
+   * @brief Required by `std::weakly_incrementable`.
+   */
+  using difference_type = std::ptrdiff_t;
+
+  /**
+   * @brief Assignable from anything.
+   */
+  struct proxy {
+    /**
+     * @brief Discard the value.
+     */
+    template <typename T>
+    constexpr auto operator=(T && /* unused */) const noexcept -> proxy const & {
+      return *this;
+    }
+  };
+
+  /**
+   * @brief The number of writes.
+   */
+  std::ptrdiff_t count = 0;
+
+  /**
+   * @brief Get the write proxy.
+   */
+  constexpr auto operator*() const noexcept -> proxy { return {}; }
+
+  /**
+   * @brief Count a write.
+   */
+  constexpr auto operator++() noexcept -> counting_sink & {
+    ++count;
+    return *this;
+  }
+
+  /**
+   * @brief Count a write.
+   */
+  constexpr auto operator++(int) noexcept -> counting_sink {
+    counting_sink tmp = *this;
+    ++count;
+    return tmp;
+  }
+};
+
+/**
+ * @brief Find the first index in `[lo, hi)` that does not satisfy `pred`, `pred` must partition the indices.
+ */
+template <typename Pred>
+constexpr auto partition_index(std::ptrdiff_t lo, std::ptrdiff_t hi, Pred pred) -> std::ptrdiff_t {
+  while (lo < hi) {
+    std::ptrdiff_t mid = lo + (hi - lo) / 2;
+    if (pred(mid)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * @brief Find how many elements of `a` and `b` precede the `d`th element of their (stable) merge.
+ *
+ * This is the co-rank of `d`, if `Keyed` is `true` the split is moved back to the start of the run of
+ * elements equivalent to the `d`th element. Hence equivalent elements are never separated, which is
+ * required by the (multi)set operations.
+ */
+template <bool Keyed, typename I1, typename I2, typename Comp, typename Proj1, typename Proj2>
+constexpr auto co_rank(I1 a,
+                       std::ptrdiff_t len_a,
+                       I2 b,
+                       std::ptrdiff_t len_b,
+                       std::ptrdiff_t d,
+                       Comp &comp,
+                       Proj1 &proj1,
+                       Proj2 &proj2) -> std::pair<std::ptrdiff_t, std::ptrdiff_t> {
+
+  // Elements of `a` come first in a tie, hence `a[i]` is taken after `b[d - i - 1]` iff
+  // `b[d - i - 1] < a[i]`.
+
+  std::ptrdiff_t i = partition_index(std::max<std::ptrdiff_t>(0, d - len_b), std::min(d, len_a), [&](auto x) {
+    return !std::invoke(comp, std::invoke(proj2, b[d - x - 1]), std::invoke(proj1, a[x]));
+  });
+
+  std::ptrdiff_t j = d - i;
+
+  if constexpr (Keyed) {
+    if (i < len_a && (j == len_b || !std::invoke(comp, std::invoke(proj2, b[j]), std::invoke(proj1, a[i])))) {
+
+      auto &&key = std::invoke(proj1, a[i]);
+
+      i = partition_index(0, i, [&](auto x) {
+        return std::invoke(comp, std::invoke(proj1, a[x]), key);
+      });
+      j = partition_index(0, j, [&](auto x) {
+        return std::invoke(comp, std::invoke(proj2, b[x]), key);
+      });
+
+    } else if (j < len_b) {
+
+      auto &&key = std::invoke(proj2, b[j]);
+
+      i = partition_index(0, i, [&](auto x) {
+        return std::invoke(comp, std::invoke(proj1, a[x]), key);
+      });
+      j = partition_index(0, j, [&](auto x) {
+        return std::invoke(comp, std::invoke(proj2, b[x]), key);
+      });
+    }
+  }
+
+  return {i, j};
+}
+
+/**
+ * @brief Sequential `std::ranges::merge` returning the output iterator.
+ */
+struct merge_op {
+  /**
+   * @brief The output size is known upfront.
+   */
+  static constexpr bool keyed = false;
+
+  /**
+   * @brief Forward to the sequential algorithm.
+   */
+  template <typename... Args>
+  LF_STATIC_CALL constexpr auto operator()(Args &&...args) LF_STATIC_CONST {
+    return std::ranges::merge(std::forward<Args>(args)...).out;
+  }
+};
+
+/**
+ * @brief Sequential `std::ranges::set_union` returning the output iterator.
+ */
+struct set_union_op {
+  /**
+   * @brief Equivalent elements must not be split.
+   */
+  static constexpr bool keyed = true;
+
+  /**
+   * @brief Forward to the sequential algorithm.
+   */
+  template <typename... Args>
+  LF_STATIC_CALL constexpr auto operator()(Args &&...args) LF_STATIC_CONST {
+    return std::ranges::set_union(std::forward<Args>(args)...).out;
+  }
+};
+
+/**
+ * @brief Sequential `std::ranges::set_intersection` returning the output iterator.
+ */
+struct set_intersection_op {
+  /**
+   * @brief Equivalent elements must not be split.
+   */
+  static constexpr bool keyed = true;
+
+  /**
+   * @brief Forward to the sequential algorithm.
+   */
+  template <typename... Args>
+  LF_STATIC_CALL constexpr auto operator()(Args &&...args) LF_STATIC_CONST {
+    return std::ranges::set_intersection(std::forward<Args>(args)...).out;
+  }
+};
+
+/**
+ * @brief Sequential `std::ranges::set_difference` returning the output iterator.
+ */
+struct set_difference_op {
+  /**
+   * @brief Equivalent elements must not be split.
+   */
+  static constexpr bool keyed = true;
+
+  /**
+   * @brief Forward to the sequential algorithm.
+   */
+  template <typename... Args>
+  LF_STATIC_CALL constexpr auto operator()(Args &&...args) LF_STATIC_CONST {
+    return std::ranges::set_difference(std::forward<Args>(args)...).out;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::merge` and the set operations.
+ *
+ * The merged sequence is cut into chunks of `n` elements by co-ranking: a binary search for the split of
+ * each chunk boundary in both inputs. A merge then writes every chunk in parallel at a known offset, the
+ * set operations count the output of each chunk in a first pass and then write in a second pass.
+ */
+template <typename Op>
+struct merge_overload {
+  /**
+   * @brief Co-ranking implementation.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            std::sized_sentinel_for<I2> S2,
+            std::random_access_iterator O,
+            std::copy_constructible Comp = std::ranges::less,
+            std::copy_constructible Proj1 = std::identity,
+            std::copy_constructible Proj2 = std::identity>
+    requires std::mergeable<I1, I2, O, Comp, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I1 head1,
+                                 S1 tail1,
+                                 I2 head2,
+                                 S2 tail2,
+                                 O out,
+                                 std::iter_difference_t<I1> n,
+                                 Comp comp = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<O> {
+
+    LF_ASSERT(n > 0);
+
+    std::ptrdiff_t len1 = tail1 - head1;
+    std::ptrdiff_t len2 = tail2 - head2;
+
+    LF_ASSERT(len1 >= 0 && len2 >= 0);
+
+    std::ptrdiff_t total = len1 + len2;
+    std::ptrdiff_t chunk = n;
+    std::ptrdiff_t chunks = (total + chunk - 1) / chunk;
+
+    // Split of the merged sequence before the `k`th chunk.
+    auto split = [=](std::ptrdiff_t k, Comp &cmp, Proj1 &pr1, Proj2 &pr2) {
+      return detail::co_rank<Op::keyed>(
+          head1, len1, head2, len2, std::min(k * chunk, total), cmp, pr1, pr2 //
+      );
+    };
+
+    if constexpr (!Op::keyed) {
+
+      co_await lf::call(for_leaves{})(0, chunks, [=](std::ptrdiff_t k) mutable {
+        auto [i0, j0] = split(k, comp, proj1, proj2);
+        auto [i1, j1] = split(k + 1, comp, proj1, proj2);
+        Op{}(head1 + i0, head1 + i1, head2 + j0, head2 + j1, out + (i0 + j0), comp, proj1, proj2);
+      });
+
+      co_await lf::join;
+
+      co_return out + total;
+
+    } else {
+
+      std::vector<std::pair<std::ptrdiff_t, std::ptrdiff_t>> bounds(static_cast<std::size_t>(chunks + 1));
+      std::vector<std::ptrdiff_t> offset(static_cast<std::size_t>(chunks + 1));
+
+      bounds.back() = {len1, len2};
+
+      // Pass 1: split and count.
+
+      co_await lf::call(for_leaves{})(0, chunks, [=, &bounds, &offset](std::ptrdiff_t k) mutable {
+        auto [i0, j0] = split(k, comp, proj1, proj2);
+        auto [i1, j1] = split(k + 1, comp, proj1, proj2);
+
+        bounds[static_cast<std::size_t>(k)] = {i0, j0};
+
+        offset[static_cast<std::size_t>(k + 1)] =
+            Op{}(head1 + i0, head1 + i1, head2 + j0, head2 + j1, detail::counting_sink{}, comp, proj1, proj2)
+                .count;
+      });
+
+      co_await lf::join;
+
+      std::partial_sum(offset.begin(), offset.end(), offset.begin());
+
+      // Pass 2: write each chunk at its offset.
+
+      co_await lf::call(for_leaves{})(0, chunks, [=, &bounds, &offset](std::ptrdiff_t k) mutable {
+        auto [i0, j0] = bounds[static_cast<std::size_t>(k)];
+        auto [i1, j1] = bounds[static_cast<std::size_t>(k + 1)];
+        Op{}(head1 + i0,
+             head1 + i1,
+             head2 + j0,
+             head2 + j1,
+             out + offset[static_cast<std::size_t>(k)],
+             comp,
+             proj1,
+             proj2);
+      });
+
+      co_await lf::join;
+
+      co_return out + offset.back();
+    }
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I1,
+            std::sized_sentinel_for<I1> S1,
+            std::random_access_iterator I2,
+            std::sized_sentinel_for<I2> S2,
+            std::random_access_iterator O,
+            std::copy_constructible Comp = std::ranges::less,
+            std::copy_constructible Proj1 = std::identity,
+            std::copy_constructible Proj2 = std::identity>
+    requires std::mergeable<I1, I2, O, Comp, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 I1 head1,
+                                 S1 tail1,
+                                 I2 head2,
+                                 S2 tail2,
+                                 O out,
+                                 Comp comp = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(head1, tail1, head2, tail2, out, detail::k_merge_grain, comp, proj1, proj2);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R1,
+            std::ranges::random_access_range R2,
+            std::random_access_iterator O,
+            std::copy_constructible Comp = std::ranges::less,
+            std::copy_constructible Proj1 = std::identity,
+            std::copy_constructible Proj2 = std::identity>
+    requires std::ranges::sized_range<R1> && std::ranges::sized_range<R2> &&
+             std::mergeable<std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>, O, Comp, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R1 &&range1,
+                                 R2 &&range2,
+                                 O out,
+                                 std::ranges::range_difference_t<R1> n,
+                                 Comp comp = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(std::ranges::begin(range1),
+                                  std::ranges::end(range1),
+                                  std::ranges::begin(range2),
+                                  std::ranges::end(range2),
+                                  out,
+                                  n,
+                                  comp,
+                                  proj1,
+                                  proj2);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range default chunk size version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R1,
+            std::ranges::random_access_range R2,
+            std::random_access_iterator O,
+            std::copy_constructible Comp = std::ranges::less,
+            std::copy_constructible Proj1 = std::identity,
+            std::copy_constructible Proj2 = std::identity>
+    requires std::ranges::sized_range<R1> && std::ranges::sized_range<R2> &&
+             std::mergeable<std::ranges::iterator_t<R1>, std::ranges::iterator_t<R2>, O, Comp, Proj1, Proj2>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R1 &&range1,
+                                 R2 &&range2,
+                                 O out,
+                                 Comp comp = {},
+                                 Proj1 proj1 = {},
+                                 Proj2 proj2 = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(std::ranges::begin(range1),
+                                  std::ranges::end(range1),
+                                  std::ranges::begin(range2),
+                                  std::ranges::end(range2),
+                                  out,
+                                  detail::k_merge_grain,
+                                  comp,
+                                  proj1,
+                                  proj2);
+    co_await lf::join;
+    co_return end;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::unique_copy`.
+ */
+struct unique_copy_overload {
+  /**
+   * @brief Two pass implementation, count the survivors of each chunk then write them.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            std::copy_constructible Proj = std::identity,
+            std::indirect_equivalence_relation<std::projected<I, Proj>> Comp = std::ranges::equal_to>
+    requires std::indirectly_copyable<I, O> && std::copy_constructible<Comp>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 S tail,
+                                 O out,
+                                 std::iter_difference_t<I> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+
+    LF_ASSERT(n > 0);
+
+    std::ptrdiff_t len = tail - head;
+
+    LF_ASSERT(len >= 0);
+
+    std::ptrdiff_t chunk = n;
+    std::ptrdiff_t chunks = (len + chunk - 1) / chunk;
+
+    // Test if `head[i]` is the first of a run of equivalent elements.
+    auto first = [=](std::ptrdiff_t i, Comp &cmp, Proj &prj) -> bool {
+      return i == 0 || !std::invoke(cmp, std::invoke(prj, head[i - 1]), std::invoke(prj, head[i]));
+    };
+
+    std::vector<std::ptrdiff_t> offset(static_cast<std::size_t>(chunks + 1));
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      std::ptrdiff_t count = 0;
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        count += first(i, comp, proj) ? 1 : 0;
+      }
+      offset[static_cast<std::size_t>(k + 1)] = count;
+    });
+
+    co_await lf::join;
+
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      O dest = out + offset[static_cast<std::size_t>(k)];
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        if (first(i, comp, proj)) {
+          *dest = head[i];
+          ++dest;
+        }
+      }
+    });
+
+    co_await lf::join;
+
+    co_return out + offset.back();
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            std::copy_constructible Proj = std::identity,
+            std::indirect_equivalence_relation<std::projected<I, Proj>> Comp = std::ranges::equal_to>
+    requires std::indirectly_copyable<I, O> && std::copy_constructible<Comp>
+  LF_STATIC_CALL auto
+  operator()(auto self, I head, S tail, O out, Comp comp = {}, Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(head, tail, out, detail::k_merge_grain, comp, proj);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            std::copy_constructible Proj = std::identity,
+            std::indirect_equivalence_relation<std::projected<std::ranges::iterator_t<R>, Proj>> Comp =
+                std::ranges::equal_to>
+    requires std::ranges::sized_range<R> && std::indirectly_copyable<std::ranges::iterator_t<R>, O> &&
+             std::copy_constructible<Comp>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R &&range,
+                                 O out,
+                                 std::ranges::range_difference_t<R> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(std::ranges::begin(range), std::ranges::end(range), out, n, comp, proj);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range default chunk size version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            std::copy_constructible Proj = std::identity,
+            std::indirect_equivalence_relation<std::projected<std::ranges::iterator_t<R>, Proj>> Comp =
+                std::ranges::equal_to>
+    requires std::ranges::sized_range<R> && std::indirectly_copyable<std::ranges::iterator_t<R>, O> &&
+             std::copy_constructible<Comp>
+  LF_STATIC_CALL auto
+  operator()(auto self, R &&range, O out, Comp comp = {}, Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    O end;
+    co_await lf::call(&end, self)(
+        std::ranges::begin(range), std::ranges::end(range), out, detail::k_merge_grain, comp, proj //
+    );
+    co_await lf::join;
+    co_return end;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel implementation of `std::ranges::merge`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I1,
+ *              std::sized_sentinel_for<I1> S1,
+ *              std::random_access_iterator I2,
+ *              std::sized_sentinel_for<I2> S2,
+ *              std::random_access_iterator O,
+ *              class Comp = std::ranges::less,
+ *              class Proj1 = std::identity,
+ *              class Proj2 = std::identity
+ *              >
+ *      requires std::mergeable<I1, I2, O, Comp, Proj1, Proj2>
+ *    auto merge(I1 head1, S1 tail1, I2 head2, S2 tail2, O out, std::iter_difference_t<I1> n,
+ *               Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) -> O;
+ *
+ * Overloads exist for random-access ranges (instead of the ``head``/``tail`` pairs) and ``n`` can be omitted
+ * (which will set ``n = 4096``). Returns the end of the output.
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::vector<int> out(a.size() + b.size());
+ *
+ *    co_await just[merge](a, b, out.begin(), 1024);
+ *
+ * \endrst
+ *
+ * The merged sequence is cut into chunks of ``n`` elements, the split of each chunk boundary in both inputs
+ * is found by binary search (co-ranking) and then every chunk is merged sequentially in parallel. The
+ * merge is stable.
+ *
+ * The comparator and projections must be regular (not async) functions. This function will make an
+ * implementation defined number of copies of the function objects and may invoke these copies concurrently.
+ */
+inline constexpr impl::merge_overload<impl::detail::merge_op> merge = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::set_union`.
+ *
+ * Accepts the same arguments as `lf::merge`, runs of equivalent elements are never split between chunks
+ * hence, a chunk may be larger than ``n``. The output of each chunk is counted in a first pass and written
+ * in a second pass.
+ */
+inline constexpr impl::merge_overload<impl::detail::set_union_op> set_union = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::set_intersection`.
+ *
+ * Accepts the same arguments as `lf::set_union`.
+ */
+inline constexpr impl::merge_overload<impl::detail::set_intersection_op> set_intersection = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::set_difference`.
+ *
+ * Accepts the same arguments as `lf::set_union`.
+ */
+inline constexpr impl::merge_overload<impl::detail::set_difference_op> set_difference = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::unique_copy`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::random_access_iterator O,
+ *              class Proj = std::identity,
+ *              std::indirect_equivalence_relation<std::projected<I, Proj>> Comp = std::ranges::equal_to
+ *              >
+ *      requires std::indirectly_copyable<I, O>
+ *    auto unique_copy(I head, S tail, O out, std::iter_difference_t<I> n,
+ *                     Comp comp = {}, Proj proj = {}) -> O;
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 4096``). Returns the end of the output.
+ *
+ * \endrst
+ *
+ * Copies the first element of every run of equivalent elements to ``out``. The input and output ranges
+ * must not overlap. The survivors of each chunk are counted in a first pass and written in a second pass.
+ *
+ * The comparator and projection must be regular (not async) functions.
+ */
+inline constexpr impl::unique_copy_overload unique_copy = {};
+
+} // namespace lf
+
+#endif /* E3A1D7C9_6F2B_4B58_9E14_7C0D5A82F3B6 */
@@ -0,0 +1,837 @@
+#ifndef B6D29E47_0C3A_4F81_9A7E_D45F1B83C062
+#define B6D29E47_0C3A_4F81_9A7E_D45F1B83C062
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min, merge, move, nth_element, sort, copy
+#include <array>       // for array
+#include <concepts>    // for copy_constructible, copyable, default_initializable
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <cstdint>     // for uint64_t
+#include <functional>  // for identity, invoke, ranges::less, ranges::greater
+#include <iterator>    // for random_access_iterator, sortable, mergeable, make_move_iterator, iter_move
+#include <numeric>     // for partial_sum
+#include <ranges>      // for begin, end, iterator_t, random_access_range, sized_range
+#include <type_traits> // for remove_cvref_t, invoke_result_t
+#include <vector>      // for vector
+
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/algorithm/merge.hpp"           // for co_rank
+#include "libfork/core/control_flow.hpp"         // for call, fork, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST, LF_TRY
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file nth_element.hpp
+ *
+ * @brief Parallel selection: nth element, partial sorting and top-k.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief Test if the elements of `I` can be selected/sorted with `Comp` and a (copyable) projected key.
+ */
+template <typename I, typename Comp, typename Proj>
+concept selectable =
+    std::sortable<I, Comp, Proj> &&                              //
+    std::copy_constructible<Comp> &&                             //
+    std::copy_constructible<Proj> &&                             //
+    std::default_initializable<std::iter_value_t<I>> &&          //
+    std::copyable<std::iter_value_t<std::projected<I, Proj>>> && //
+    std::mergeable<std::move_iterator<I>,
+                   std::move_iterator<I>,
+                   typename std::vector<std::iter_value_t<I>>::iterator,
+                   Comp,
+                   Proj,
+                   Proj>;
+
+/**
+ * @brief Test if the `k` best elements of `I` can be selected, through a buffer, into `O`.
+ */
+template <typename I, typename O, typename Comp, typename Proj>
+concept top_k_selectable =
+    selectable<typename std::vector<std::iter_value_t<I>>::iterator, Comp, Proj> && //
+    std::indirect_strict_weak_order<Comp, std::projected<I, Proj>> &&                //
+    std::indirectly_copyable<I, typename std::vector<std::iter_value_t<I>>::iterator> &&
+    std::indirectly_movable<typename std::vector<std::iter_value_t<I>>::iterator, O>;
+
+namespace detail {
+
+/**
+ * @brief The chunk size used when `n` is omitted.
+ *
+ * Ranges no longer than a chunk are selected/sorted serially.
+ */
+inline constexpr std::ptrdiff_t k_select_grain = 16 * 1024;
+
+/**
+ * @brief The number of keys sampled to choose the pivots.
+ */
+inline constexpr std::ptrdiff_t k_sample = 1024;
+
+/**
+ * @brief The distance in the (sorted) sample between the target rank and the pivots.
+ *
+ * For a sample of `s` keys a distance of `sqrt(s)` makes it likely the target lies between the pivots, while
+ * the range between the pivots holds roughly a `2 / sqrt(s)` fraction of the input.
+ */
+inline constexpr std::ptrdiff_t k_sample_gap = 32;
+
+/**
+ * @brief The key type of the elements of `I`.
+ */
+template <typename I, typename Proj>
+using sort_key_t = std::iter_value_t<std::projected<I, Proj>>;
+
+/**
+ * @brief A deterministic hash used to pick sample positions.
+ */
+constexpr auto splitmix(std::uint64_t x) noexcept -> std::uint64_t {
+  x += 0x9E3779B97F4A7C15;
+  x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9;
+  x = (x ^ (x >> 27U)) * 0x94D049BB133111EB;
+  return x ^ (x >> 31U);
+}
+
+/**
+ * @brief Get a sorted sample of (at most `k_sample`) keys from `[head, head + len)`.
+ */
+template <std::random_access_iterator I, typename Comp, typename Proj>
+auto sorted_sample(I head, std::ptrdiff_t len, std::uint64_t seed, Comp &comp, Proj &proj)
+    -> std::vector<sort_key_t<I, Proj>> {
+
+  std::ptrdiff_t size = std::min(len, k_sample);
+
+  std::vector<sort_key_t<I, Proj>> keys;
+
+  keys.reserve(static_cast<std::size_t>(size));
+
+  for (std::ptrdiff_t i = 0; i < size; ++i) {
+    std::ptrdiff_t pos = i;
+
+    if (size != len) {
+      auto hash = splitmix(seed + static_cast<std::uint64_t>(i));
+      pos = static_cast<std::ptrdiff_t>(hash % static_cast<std::uint64_t>(len));
+    }
+
+    keys.emplace_back(std::invoke(proj, head[pos]));
+  }
+
+  std::ranges::sort(keys, comp);
+
+  return keys;
+}
+
+/**
+ * @brief Count the elements of each of the three buckets in every chunk.
+ *
+ * Returns bucket-major (exclusive) offsets, `offset[b * chunks + k]` is the position of the first element of
+ * the `k`th chunk in bucket `b` and `offset[3 * chunks]` is the length.
+ */
+struct bucket_count {
+  /**
+   * @brief The histograms are scanned serially, there are only three per chunk.
+   */
+  template <std::random_access_iterator I, typename Bucket>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, std::ptrdiff_t len, std::ptrdiff_t chunk, Bucket bucket)
+      LF_STATIC_CONST->lf::task<std::vector<std::ptrdiff_t>> {
+
+    std::ptrdiff_t chunks = (len + chunk - 1) / chunk;
+
+    std::vector<std::ptrdiff_t> offset(static_cast<std::size_t>(3 * chunks + 1));
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      std::array<std::ptrdiff_t, 3> hist{};
+
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        ++hist[static_cast<std::size_t>(std::invoke(bucket, head[i]))];
+      }
+
+      for (std::ptrdiff_t b = 0; b < 3; ++b) {
+        offset[static_cast<std::size_t>(b * chunks + k + 1)] = hist[static_cast<std::size_t>(b)];
+      }
+    });
+
+    co_await lf::join;
+
+    std::partial_sum(offset.begin(), offset.end(), offset.begin());
+
+    co_return offset;
+  }
+};
+
+/**
+ * @brief Stably move (or copy) the elements of the buckets less than `keep` to `out`, using the offsets from
+ * `bucket_count`.
+ */
+template <bool Move>
+struct bucket_scatter {
+  /**
+   * @brief Each chunk is scattered in parallel.
+   */
+  template <std::random_access_iterator I, std::random_access_iterator O, typename Bucket>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 std::ptrdiff_t len,
+                                 O out,
+                                 std::ptrdiff_t chunk,
+                                 std::vector<std::ptrdiff_t> const *offset,
+                                 std::ptrdiff_t keep,
+                                 Bucket bucket) LF_STATIC_CONST->lf::task<> {
+
+    std::ptrdiff_t chunks = (len + chunk - 1) / chunk;
+
+    co_await lf::call(for_leaves{})(0, chunks, [=](std::ptrdiff_t k) mutable {
+      std::array<std::ptrdiff_t, 3> pos{};
+
+      for (std::ptrdiff_t b = 0; b < keep; ++b) {
+        pos[static_cast<std::size_t>(b)] = (*offset)[static_cast<std::size_t>(b * chunks + k)];
+      }
+
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        if (std::ptrdiff_t b = std::invoke(bucket, head[i]); b < keep) {
+          if constexpr (Move) {
+            out[pos[static_cast<std::size_t>(b)]++] = std::ranges::iter_move(head + i);
+          } else {
+            out[pos[static_cast<std::size_t>(b)]++] = head[i];
+          }
+        }
+      }
+    });
+
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Move `[from, from + len)` to `to` in parallel.
+ */
+template <std::random_access_iterator I, std::random_access_iterator O>
+auto move_blocks(I from, std::ptrdiff_t len, O to, std::ptrdiff_t chunk) {
+  return [=](std::ptrdiff_t k) {
+    std::ptrdiff_t lo = k * chunk;
+    std::ranges::move(from + lo, from + std::min(lo + chunk, len), to + lo);
+  };
+}
+
+/**
+ * @brief Sample-select: repeatedly partition around a pair of sampled pivots that bracket the target.
+ */
+struct nth_element_impl {
+  /**
+   * @brief Partitions are three-way and out-of-place, through a buffer the size of the input.
+   */
+  template <std::random_access_iterator I, typename Comp, typename Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 std::ptrdiff_t len,
+                                 std::ptrdiff_t nth,
+                                 std::ptrdiff_t chunk,
+                                 Comp comp,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(0 <= nth && nth <= len);
+
+    if (nth == len) {
+      co_return;
+    }
+
+    std::ptrdiff_t lo = 0;
+    std::ptrdiff_t hi = len;
+
+    std::vector<std::iter_value_t<I>> buf;
+
+    std::uint64_t seed = 0;
+
+    std::ptrdiff_t gap = k_sample_gap;
+
+    while (hi - lo > chunk) {
+
+      if (buf.empty()) {
+        buf.resize(static_cast<std::size_t>(len));
+      }
+
+      std::ptrdiff_t size = hi - lo;
+
+      auto keys = sorted_sample(head + lo, size, seed, comp, proj);
+
+      seed += static_cast<std::uint64_t>(keys.size());
+
+      auto frac = static_cast<double>(nth - lo) / static_cast<double>(size);
+      auto rank = static_cast<std::ptrdiff_t>(frac * static_cast<double>(keys.size()));
+
+      auto p1 = keys[static_cast<std::size_t>(std::max<std::ptrdiff_t>(rank - gap, 0))];
+      auto p2 = keys[static_cast<std::size_t>(std::min<std::ptrdiff_t>(rank + gap, std::ssize(keys) - 1))];
+
+      auto bucket = [comp, proj, p1, p2](auto &&elem) mutable -> std::ptrdiff_t {
+        auto &&key = std::invoke(proj, elem);
+        if (std::invoke(comp, key, p1)) {
+          return 0;
+        }
+        return std::invoke(comp, p2, key) ? 2 : 1;
+      };
+
+      std::vector<std::ptrdiff_t> offset;
+
+      co_await lf::call(&offset, bucket_count{})(head + lo, size, chunk, bucket);
+      co_await lf::join;
+
+      std::ptrdiff_t chunks = (size + chunk - 1) / chunk;
+
+      co_await lf::call(bucket_scatter<true>{})(head + lo, size, buf.begin(), chunk, &offset, 3, bucket);
+      co_await lf::join;
+
+      co_await lf::call(for_leaves{})(0, chunks, move_blocks(buf.begin(), size, head + lo, chunk));
+      co_await lf::join;
+
+      std::ptrdiff_t mid_lo = lo + offset[static_cast<std::size_t>(chunks)];
+      std::ptrdiff_t mid_hi = lo + offset[static_cast<std::size_t>(2 * chunks)];
+
+      if (nth < mid_lo) {
+        hi = mid_lo;
+      } else if (nth >= mid_hi) {
+        lo = mid_hi;
+      } else if (!std::invoke(comp, p1, p2)) {
+        // Every element between the pivots is equivalent to them.
+        co_return;
+      } else {
+        // If the pivots bracket everything retry with a single pivot (which always makes progress).
+        gap = mid_hi - mid_lo == size ? 0 : k_sample_gap;
+        lo = mid_lo;
+        hi = mid_hi;
+      }
+    }
+
+    std::ranges::nth_element(head + lo, head + nth, head + hi, comp, proj);
+  }
+};
+
+/**
+ * @brief A merge sort, halves are sorted in parallel and merged in parallel through `buf`.
+ */
+struct sort_impl {
+  /**
+   * @brief Ranges no longer than `chunk` are sorted serially.
+   */
+  template <std::random_access_iterator I, std::random_access_iterator B, typename Comp, typename Proj>
+  LF_STATIC_CALL auto
+  operator()(auto self, I head, std::ptrdiff_t len, B buf, std::ptrdiff_t chunk, Comp comp, Proj proj)
+      LF_STATIC_CONST->lf::task<> {
+
+    if (len <= chunk) {
+      std::ranges::sort(head, head + len, comp, proj);
+      co_return;
+    }
+
+    std::ptrdiff_t mid = len / 2;
+
+    // clang-format off
+
+    co_await lf::fork(self)(head, mid, buf, chunk, comp, proj);
+
+    LF_TRY {
+      co_await lf::call(self)(head + mid, len - mid, buf + mid, chunk, comp, proj);
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+
+    // A co-ranked merge (as in ``lf::merge``) that moves the elements.
+
+    co_await lf::call(for_leaves{})(0, (len + chunk - 1) / chunk, [=](std::ptrdiff_t k) mutable {
+      auto [i0, j0] = co_rank<false>(head, mid, head + mid, len - mid, k * chunk, comp, proj, proj);
+      auto [i1, j1] = co_rank<false>(head, mid, head + mid, len - mid, std::min(k * chunk + chunk, len),
+                                     comp, proj, proj);
+
+      std::ranges::merge(std::make_move_iterator(head + i0),
+                         std::make_move_iterator(head + i1),
+                         std::make_move_iterator(head + mid + j0),
+                         std::make_move_iterator(head + mid + j1),
+                         buf + (i0 + j0),
+                         comp,
+                         proj,
+                         proj);
+    });
+    co_await lf::join;
+
+    co_await lf::call(for_leaves{})(0, (len + chunk - 1) / chunk, move_blocks(buf, len, head, chunk));
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Select the `mid` least elements of `[head, head + len)` then sort them.
+ */
+struct partial_sort_impl {
+  /**
+   * @brief Selection is skipped if everything is to be sorted.
+   */
+  template <std::random_access_iterator I, typename Comp, typename Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 std::ptrdiff_t mid,
+                                 std::ptrdiff_t len,
+                                 std::ptrdiff_t chunk,
+                                 Comp comp,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(0 <= mid && mid <= len);
+
+    if (mid == 0) {
+      co_return;
+    }
+
+    if (mid < len) {
+      co_await lf::call(nth_element_impl{})(head, len, mid, chunk, comp, proj);
+      co_await lf::join;
+    }
+
+    if (mid <= chunk) {
+      std::ranges::sort(head, head + mid, comp, proj);
+      co_return;
+    }
+
+    std::vector<std::iter_value_t<I>> buf(static_cast<std::size_t>(mid));
+
+    co_await lf::call(sort_impl{})(head, mid, buf.begin(), chunk, comp, proj);
+    co_await lf::join;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::nth_element`.
+ */
+struct nth_element_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires selectable<I, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 I nth,
+                                 S tail,
+                                 std::iter_difference_t<I> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+    co_await lf::call(detail::nth_element_impl{})(head, tail - head, nth - head, n, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires selectable<I, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, I nth, S tail, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::nth_element_impl{})(
+        head, tail - head, nth - head, detail::k_select_grain, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && selectable<std::ranges::iterator_t<R>, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 std::ranges::iterator_t<R> nth,
+                                 std::ranges::range_difference_t<R> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+    co_await lf::call(detail::nth_element_impl{})(
+        std::ranges::begin(range), std::ranges::ssize(range), nth - std::ranges::begin(range), n, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && selectable<std::ranges::iterator_t<R>, Comp, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, std::ranges::iterator_t<R> nth, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::nth_element_impl{})(std::ranges::begin(range),
+                                                  std::ranges::ssize(range),
+                                                  nth - std::ranges::begin(range),
+                                                  detail::k_select_grain,
+                                                  comp,
+                                                  proj);
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::partial_sort`.
+ */
+struct partial_sort_overload {
+  /**
+   * @brief Iterator version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires selectable<I, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 I mid,
+                                 S tail,
+                                 std::iter_difference_t<I> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+    co_await lf::call(detail::partial_sort_impl{})(head, mid - head, tail - head, n, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires selectable<I, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */, I head, I mid, S tail, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::partial_sort_impl{})(
+        head, mid - head, tail - head, detail::k_select_grain, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && selectable<std::ranges::iterator_t<R>, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 std::ranges::iterator_t<R> mid,
+                                 std::ranges::range_difference_t<R> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    LF_ASSERT(n > 0);
+    co_await lf::call(detail::partial_sort_impl{})(
+        std::ranges::begin(range), mid - std::ranges::begin(range), std::ranges::ssize(range), n, comp, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R,
+            typename Comp = std::ranges::less,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && selectable<std::ranges::iterator_t<R>, Comp, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, std::ranges::iterator_t<R> mid, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::partial_sort_impl{})(std::ranges::begin(range),
+                                                   mid - std::ranges::begin(range),
+                                                   std::ranges::ssize(range),
+                                                   detail::k_select_grain,
+                                                   comp,
+                                                   proj);
+    co_await lf::join;
+  }
+};
+
+/**
+ * @brief Overload set for `lf::top_k`.
+ */
+struct top_k_overload {
+  /**
+   * @brief Filter the candidates that rank no worse than a sampled threshold, then partially sort them.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            typename Comp = std::ranges::greater,
+            typename Proj = std::identity>
+    requires top_k_selectable<I, O, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I head,
+                                 S tail,
+                                 O out,
+                                 std::iter_difference_t<I> k,
+                                 std::iter_difference_t<I> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(k >= 0);
+
+    std::ptrdiff_t len = tail - head;
+    std::ptrdiff_t chunk = n;
+    std::ptrdiff_t m = std::min<std::ptrdiff_t>(k, len);
+
+    if (m == 0) {
+      co_return out;
+    }
+
+    std::vector<std::iter_value_t<I>> cand;
+
+    // If few elements will be rejected filtering is not worth it.
+
+    if (len > chunk && 4 * m < len) {
+
+      auto keys = detail::sorted_sample(head, len, 0, comp, proj);
+
+      auto size = std::ssize(keys);
+      auto rank = static_cast<std::ptrdiff_t>(static_cast<double>(m) * static_cast<double>(size) /
+                                              static_cast<double>(len));
+
+      for (std::ptrdiff_t gap = detail::k_sample_gap; cand.empty(); gap *= 4) {
+
+        auto thresh = keys[static_cast<std::size_t>(std::min(rank + gap, size - 1))];
+
+        auto bucket = [comp, proj, thresh](auto &&elem) mutable -> std::ptrdiff_t {
+          return std::invoke(comp, thresh, std::invoke(proj, elem)) ? 1 : 0;
+        };
+
+        std::vector<std::ptrdiff_t> offset;
+
+        co_await lf::call(&offset, detail::bucket_count{})(head, len, chunk, bucket);
+        co_await lf::join;
+
+        std::ptrdiff_t count = offset[static_cast<std::size_t>((len + chunk - 1) / chunk)];
+
+        if (count >= m) {
+          cand.resize(static_cast<std::size_t>(count));
+          co_await lf::call(detail::bucket_scatter<false>{})(
+              head, len, cand.begin(), chunk, &offset, 1, bucket);
+          co_await lf::join;
+        } else if (rank + gap >= size - 1) {
+          // Even the worst sampled key rejects too much.
+          break;
+        }
+      }
+    }
+
+    if (cand.empty()) {
+      cand.resize(static_cast<std::size_t>(len));
+      co_await lf::call(for_leaves{})(0, (len + chunk - 1) / chunk, [=, &cand](std::ptrdiff_t b) {
+        std::ptrdiff_t lo = b * chunk;
+        std::ranges::copy(head + lo, head + std::min(lo + chunk, len), cand.begin() + lo);
+      });
+      co_await lf::join;
+    }
+
+    co_await lf::call(detail::partial_sort_impl{})(cand.begin(), m, std::ssize(cand), chunk, comp, proj);
+    co_await lf::join;
+
+    auto move_out = detail::move_blocks(cand.begin(), m, out, chunk);
+
+    co_await lf::call(for_leaves{})(0, (m + chunk - 1) / chunk, move_out);
+    co_await lf::join;
+
+    co_return out + m;
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            std::random_access_iterator O,
+            typename Comp = std::ranges::greater,
+            typename Proj = std::identity>
+    requires top_k_selectable<I, O, Comp, Proj>
+  LF_STATIC_CALL auto
+  operator()(auto self, I head, S tail, O out, std::iter_difference_t<I> k, Comp comp = {}, Proj proj = {})
+      LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(head, tail, out, k, detail::k_select_grain, comp, proj);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            typename Comp = std::ranges::greater,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && top_k_selectable<std::ranges::iterator_t<R>, O, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R &&range,
+                                 O out,
+                                 std::ranges::range_difference_t<R> k,
+                                 std::ranges::range_difference_t<R> n,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(std::ranges::begin(range), std::ranges::end(range), out, k, n, comp, proj);
+    co_await lf::join;
+    co_return end;
+  }
+
+  /**
+   * @brief Range default chunk size version.
+   */
+  template <std::ranges::random_access_range R,
+            std::random_access_iterator O,
+            typename Comp = std::ranges::greater,
+            typename Proj = std::identity>
+    requires std::ranges::sized_range<R> && top_k_selectable<std::ranges::iterator_t<R>, O, Comp, Proj>
+  LF_STATIC_CALL auto operator()(auto self,
+                                 R &&range,
+                                 O out,
+                                 std::ranges::range_difference_t<R> k,
+                                 Comp comp = {},
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<O> {
+    O end{};
+    co_await lf::call(&end, self)(
+        std::ranges::begin(range), std::ranges::end(range), out, k, detail::k_select_grain, comp, proj);
+    co_await lf::join;
+    co_return end;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel implementation of `std::ranges::nth_element`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              class Comp = std::ranges::less,
+ *              class Proj = std::identity
+ *              >
+ *      requires selectable<I, Comp, Proj>
+ *    void nth_element(I head, I nth, S tail, std::iter_difference_t<I> n, Comp comp = {}, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16384``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[nth_element](scores, scores.begin() + scores.size() / 2);
+ *
+ * \endrst
+ *
+ * Rearranges the elements such that ``*nth`` is the element that would be there if the range was sorted,
+ * no element before ``nth`` is greater than it and no element after it is less than it.
+ *
+ * While the active range is longer than ``n``, this sorts a sample of its keys and picks two pivots that
+ * bracket the target's rank in the sample. The range is partitioned (three-way) around the pivots, in
+ * parallel chunks of ``n`` elements, and the search continues in the part that contains ``nth``, which is
+ * typically the small middle part. This allocates a buffer the size of the input and the final range is
+ * handed to ``std::ranges::nth_element``.
+ */
+inline constexpr impl::nth_element_overload nth_element = {};
+
+/**
+ * @brief A parallel implementation of `std::ranges::partial_sort`.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              class Comp = std::ranges::less,
+ *              class Proj = std::identity
+ *              >
+ *      requires selectable<I, Comp, Proj>
+ *    void partial_sort(I head, I mid, S tail, std::iter_difference_t<I> n, Comp comp = {}, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16384``).
+ *
+ * \endrst
+ *
+ * Rearranges the elements such that ``[head, mid)`` holds the ``mid - head`` least elements in sorted order,
+ * the order of the remaining elements is unspecified. This is ``lf::nth_element`` followed by a parallel
+ * merge sort (co-ranked as in ``lf::merge``) of the first part, which is not stable.
+ */
+inline constexpr impl::partial_sort_overload partial_sort = {};
+
+/**
+ * @brief Copy the ``k`` best elements of a range, in order, to an output iterator.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              std::random_access_iterator O,
+ *              class Comp = std::ranges::greater,
+ *              class Proj = std::identity
+ *              >
+ *    O top_k(I head, S tail, O out, std::iter_difference_t<I> k, std::iter_difference_t<I> n,
+ *            Comp comp = {}, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16384``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::vector<item> best(10);
+ *
+ *    co_await just[top_k](items, best.begin(), 10, std::ranges::greater{}, &item::score);
+ *
+ * \endrst
+ *
+ * Writes the ``min(k, tail - head)`` first elements of the input, as ordered by ``comp`` (by default the
+ * largest), to ``out`` in order and returns an iterator past the last element written. The input is not
+ * modified.
+ *
+ * If ``k`` is small relative to the input, a threshold is chosen from a sample of the keys and only the
+ * elements that rank no worse than it (typically a little more than ``k``) are copied, in parallel, to a
+ * buffer which is then partially sorted with ``lf::partial_sort``. Otherwise the whole input is copied.
+ */
+inline constexpr impl::top_k_overload top_k = {};
+
+} // namespace lf
+
+#endif /* B6D29E47_0C3A_4F81_9A7E_D45F1B83C062 */
@@ -0,0 +1,313 @@
+#ifndef D8B3F061_4C2E_4A97_B5D1_6E0A9C3F7B24
+#define D8B3F061_4C2E_4A97_B5D1_6E0A9C3F7B24
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>   // for max, min, move
+#include <array>       // for array
+#include <bit>         // for bit_cast
+#include <concepts>    // for integral, floating_point, same_as, copy_constructible, regular_invocable
+#include <cstddef>     // for ptrdiff_t, size_t
+#include <cstdint>     // for uint32_t, uint64_t
+#include <functional>  // for identity, invoke, plus
+#include <iterator>    // for random_access_iterator, sized_sentinel_for, iter_value_t, iter_reference_t
+#include <limits>      // for numeric_limits
+#include <ranges>      // for begin, end, random_access_range, sized_range, iterator_t
+#include <type_traits> // for make_unsigned_t, remove_cvref_t, invoke_result_t, conditional_t
+#include <vector>      // for vector
+
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/algorithm/scan.hpp"            // for scan
+#include "libfork/core/control_flow.hpp"         // for call, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file radix_sort.hpp
+ *
+ * @brief A parallel least significant digit radix sort.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief Test if `T` is an integer (excluding `bool`) or a 32/64-bit floating point type.
+ */
+template <typename T>
+concept radix_key = (std::integral<T> && !std::same_as<T, bool>) ||                  //
+                    (std::floating_point<T> && std::numeric_limits<T>::is_iec559 && //
+                     (sizeof(T) == 4 || sizeof(T) == 8));
+
+/**
+ * @brief Test if `Proj` extracts a `radix_key` from the elements of `I`.
+ */
+template <typename Proj, typename I>
+concept radix_projection =
+    std::copy_constructible<Proj> &&                            //
+    std::regular_invocable<Proj &, std::iter_reference_t<I>> && //
+    radix_key<std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>>;
+
+namespace detail {
+
+/**
+ * @brief The number of bits in a digit.
+ */
+inline constexpr int k_radix_bits = 8;
+
+/**
+ * @brief The number of buckets per pass.
+ */
+inline constexpr std::ptrdiff_t k_radix = std::ptrdiff_t{1} << k_radix_bits;
+
+/**
+ * @brief The chunk size used when `n` is omitted.
+ *
+ * Every chunk costs a histogram of `k_radix` counters per pass.
+ */
+inline constexpr std::ptrdiff_t k_radix_grain = 16 * 1024;
+
+/**
+ * @brief Map a key to an unsigned integer with the same ordering.
+ *
+ * Signed integers have their sign bit flipped, floating point numbers have their sign bit flipped if
+ * positive and all bits flipped if negative.
+ */
+template <radix_key T>
+constexpr auto radix_bits(T key) noexcept {
+  if constexpr (std::unsigned_integral<T>) {
+    return key;
+  } else if constexpr (std::signed_integral<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(key) ^ (U{1} << (std::numeric_limits<U>::digits - 1)));
+  } else {
+    using U = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    constexpr U sign = U{1} << (std::numeric_limits<U>::digits - 1);
+    U bits = std::bit_cast<U>(key);
+    return (bits & sign) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+  }
+}
+
+/**
+ * @brief A single stable counting-sort pass on the digit at `shift`, moving from `from` to `to`.
+ */
+struct radix_pass {
+  /**
+   * @brief Returns `false` (and moves nothing) if every key has the same digit.
+   */
+  template <std::random_access_iterator From, std::random_access_iterator To, typename Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 From from,
+                                 To to,
+                                 std::ptrdiff_t len,
+                                 std::ptrdiff_t chunk,
+                                 int shift,
+                                 Proj proj) LF_STATIC_CONST->lf::task<bool> {
+
+    std::ptrdiff_t chunks = (len + chunk - 1) / chunk;
+
+    auto digit = [shift](auto key) -> std::ptrdiff_t {
+      return static_cast<std::ptrdiff_t>((radix_bits(key) >> shift) & (k_radix - 1));
+    };
+
+    // Digit-major histograms, `offset[d * chunks + k + 1]` counts the elements of chunk `k` with digit `d`,
+    // hence the scan orders elements by digit and then by chunk, which makes the pass stable.
+
+    std::vector<std::ptrdiff_t> offset(static_cast<std::size_t>(k_radix * chunks + 1));
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      std::array<std::ptrdiff_t, k_radix> hist{};
+
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        ++hist[static_cast<std::size_t>(digit(std::invoke(proj, from[i])))];
+      }
+
+      for (std::ptrdiff_t d = 0; d < k_radix; ++d) {
+        offset[static_cast<std::size_t>(d * chunks + k + 1)] = hist[static_cast<std::size_t>(d)];
+      }
+    });
+
+    co_await lf::join;
+
+    co_await lf::call(lf::scan)(offset.begin(), offset.end(), k_radix, std::plus<>{});
+    co_await lf::join;
+
+    for (std::ptrdiff_t d = 0; d < k_radix; ++d) {
+      std::ptrdiff_t lo = offset[static_cast<std::size_t>(d * chunks)];
+      std::ptrdiff_t hi = offset[static_cast<std::size_t>((d + 1) * chunks)];
+      if (hi - lo == len) {
+        co_return false;
+      }
+    }
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &offset](std::ptrdiff_t k) mutable {
+      std::array<std::ptrdiff_t, k_radix> pos;
+
+      for (std::ptrdiff_t d = 0; d < k_radix; ++d) {
+        pos[static_cast<std::size_t>(d)] = offset[static_cast<std::size_t>(d * chunks + k)];
+      }
+
+      for (std::ptrdiff_t i = k * chunk, end = std::min(i + chunk, len); i < end; ++i) {
+        to[pos[static_cast<std::size_t>(digit(std::invoke(proj, from[i])))]++] = std::move(from[i]);
+      }
+    });
+
+    co_await lf::join;
+
+    co_return true;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Overload set for `lf::radix_sort`.
+ */
+struct radix_sort_overload {
+  /**
+   * @brief One pass per digit, ping-ponging through a buffer.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            radix_projection<I> Proj = std::identity>
+    requires std::movable<std::iter_value_t<I>> && std::default_initializable<std::iter_value_t<I>> &&
+             std::indirectly_movable<I, I>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I head, S tail, std::iter_difference_t<I> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+
+    LF_ASSERT(n > 0);
+
+    using key_t = std::remove_cvref_t<std::invoke_result_t<Proj &, std::iter_reference_t<I>>>;
+
+    std::ptrdiff_t len = tail - head;
+    std::ptrdiff_t chunk = n;
+
+    LF_ASSERT(len >= 0);
+
+    if (len <= 1) {
+      co_return;
+    }
+
+    std::vector<std::iter_value_t<I>> buf(static_cast<std::size_t>(len));
+
+    bool in_buf = false;
+
+    for (int shift = 0; shift < std::numeric_limits<decltype(detail::radix_bits(key_t{}))>::digits;
+         shift += detail::k_radix_bits) {
+
+      bool moved = false;
+
+      if (in_buf) {
+        co_await lf::call(&moved, detail::radix_pass{})(buf.begin(), head, len, chunk, shift, proj);
+      } else {
+        co_await lf::call(&moved, detail::radix_pass{})(head, buf.begin(), len, chunk, shift, proj);
+      }
+
+      co_await lf::join;
+
+      in_buf = in_buf != moved;
+    }
+
+    if (in_buf) {
+      // An odd number of passes moved the data, move it back.
+      auto move_back = [&buf, head, len, chunk](std::ptrdiff_t k) {
+        auto lo = k * chunk;
+        std::ranges::move(buf.begin() + lo, buf.begin() + std::min(lo + chunk, len), head + lo);
+      };
+      co_await lf::call(for_leaves{})(0, (len + chunk - 1) / chunk, move_back);
+      co_await lf::join;
+    }
+  }
+
+  /**
+   * @brief Default chunk size version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            radix_projection<I> Proj = std::identity>
+    requires std::movable<std::iter_value_t<I>> && std::default_initializable<std::iter_value_t<I>> &&
+             std::indirectly_movable<I, I>
+  LF_STATIC_CALL auto
+  operator()(auto self, I head, S tail, Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(head, tail, detail::k_radix_grain, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            radix_projection<std::ranges::iterator_t<R>> Proj = std::identity>
+    requires std::ranges::sized_range<R> && std::movable<std::ranges::range_value_t<R>> &&
+             std::default_initializable<std::ranges::range_value_t<R>> &&
+             std::indirectly_movable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>>
+  LF_STATIC_CALL auto
+  operator()(auto self, R &&range, std::ranges::range_difference_t<R> n, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), n, proj);
+    co_await lf::join;
+  }
+
+  /**
+   * @brief Range default chunk size version, dispatches to the iterator version.
+   */
+  template <std::ranges::random_access_range R,
+            radix_projection<std::ranges::iterator_t<R>> Proj = std::identity>
+    requires std::ranges::sized_range<R> && std::movable<std::ranges::range_value_t<R>> &&
+             std::default_initializable<std::ranges::range_value_t<R>> &&
+             std::indirectly_movable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>>
+  LF_STATIC_CALL auto operator()(auto self, R &&range, Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(self)(std::ranges::begin(range), std::ranges::end(range), detail::k_radix_grain, proj);
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel, stable, least significant digit radix sort.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              radix_projection<I> Proj = std::identity
+ *              >
+ *    void radix_sort(I head, S tail, std::iter_difference_t<I> n, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``) and ``n`` can be omitted
+ * (which will set ``n = 16384``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[radix_sort](particles, [](particle const &p) { return p.morton; });
+ *
+ * \endrst
+ *
+ * Sorts the elements in ascending order of the key extracted by ``proj``, which must be a regular function
+ * returning an integer or a 32/64-bit IEEE floating point number. Negative zero sorts before positive zero
+ * and NaNs sort by their sign bit (before or after every other key).
+ *
+ * Each of the ``sizeof(key)`` passes builds a histogram of one byte of the key for every chunk of ``n``
+ * elements in parallel, combines them with ``lf::scan`` and then scatters each chunk in parallel. Passes in
+ * which every key shares the same byte are skipped. This allocates a buffer the size of the input.
+ */
+inline constexpr impl::radix_sort_overload radix_sort = {};
+
+} // namespace lf
+
+#endif /* D8B3F061_4C2E_4A97_B5D1_6E0A9C3F7B24 */
@@ -16,6 +16,7 @@
 #include <type_traits> // for conditional_t
 
 #include "libfork/algorithm/constraints.hpp" // for indirectly_scannable, projected
+#include "libfork/algorithm/views.hpp"       // for fused_view, fused_projection
 #include "libfork/core/control_flow.hpp"     // for call, dispatch, fork, join
 #include "libfork/core/invocable.hpp"        // for async_invocable
 #include "libfork/core/just.hpp"             // for just
@@ -653,6 +654,41 @@ struct scan_overload {
         std::ranges::begin(range), std::ranges::end(range), std::ranges::begin(range), 1, bop, proj //
     );
   }
+  /**
+   * @brief [fused,chunk,output] version.
+   */
+  template <class V,                                                                                 //
+            class... Stages,                                                                         //
+            std::random_access_iterator O,                                                           //
+            indirectly_scannable<O, projected<std::ranges::iterator_t<V>, fused_projection<Stages...>>> Bop //
+            >
+    requires (!fused_view<V, Stages...>::filtered)
+  auto LF_STATIC_CALL operator()(auto /* unused */, //
+                                 fused_view<V, Stages...> view,
+                                 O out,
+                                 std::ranges::range_difference_t<V> n,
+                                 Bop bop) LF_STATIC_CONST->task<void> {
+    co_return co_await lf::just(impl::scan_impl{})(
+        std::ranges::begin(view.base()), std::ranges::end(view.base()), out, n, bop, view.projection() //
+    );
+  }
+  /**
+   * @brief [fused,n = 1,output] version.
+   */
+  template <class V,                                                                                 //
+            class... Stages,                                                                         //
+            std::random_access_iterator O,                                                           //
+            indirectly_scannable<O, projected<std::ranges::iterator_t<V>, fused_projection<Stages...>>> Bop //
+            >
+    requires (!fused_view<V, Stages...>::filtered)
+  auto LF_STATIC_CALL operator()(auto /* unused */, //
+                                 fused_view<V, Stages...> view,
+                                 O out,
+                                 Bop bop) LF_STATIC_CONST->task<void> {
+    co_return co_await lf::just(impl::scan_impl{})(
+        std::ranges::begin(view.base()), std::ranges::end(view.base()), out, 1, bop, view.projection() //
+    );
+  }
 };
 
 } // namespace impl
@@ -675,7 +711,9 @@ struct scan_overload {
  *    void scan(I beg, S end, O out, std::iter_difference_t<I> n, Bop bop, Proj proj = {});
  *
  * Overloads exist for a random-access range (instead of ``head`` and ``tail``), in place scans (omit the
- * `out` iterator) and, the chunk size, ``n``, can be omitted (which will set ``n = 1``).
+ * `out` iterator) and, the chunk size, ``n``, can be omitted (which will set ``n = 1``). The range may also
+ * be a pipeline of ``lf::views::transform`` stages (without a projection), which are then applied as the
+ * input is read.
  *
  * Exemplary usage:
  *
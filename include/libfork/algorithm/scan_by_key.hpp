@@ -0,0 +1,323 @@
+#ifndef C19F6B3E_7A54_4D28_9E0B_2F8D4A6C1E73
+#define C19F6B3E_7A54_4D28_9E0B_2F8D4A6C1E73
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>  // for any_of, min
+#include <concepts>   // for convertible_to
+#include <cstddef>    // for ptrdiff_t, size_t
+#include <functional> // for identity, invoke
+#include <iterator>   // for random_access_iterator, sized_sentinel_for, iter_value_t, iter_reference_t
+#include <optional>   // for optional
+#include <ranges>     // for begin, ssize, iterator_t, random_access_range, sized_range
+#include <utility>    // for move, forward
+#include <vector>     // for vector
+
+#include "libfork/algorithm/exclusive_scan.hpp"  // for regular_scannable, k_scan_grain
+#include "libfork/algorithm/impl/for_leaves.hpp" // for for_leaves
+#include "libfork/core/control_flow.hpp"         // for call, join
+#include "libfork/core/macro.hpp"                // for LF_ASSERT, LF_STATIC_CALL, LF_STATIC_CONST
+#include "libfork/core/task.hpp"                 // for task
+
+/**
+ * @file scan_by_key.hpp
+ *
+ * @brief A parallel segmented scan.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief Test if `F` is an iterator over segment head flags.
+ */
+template <typename F>
+concept head_flag_iterator =
+    std::random_access_iterator<F> && std::convertible_to<std::iter_reference_t<F>, bool>;
+
+namespace detail {
+
+/**
+ * @brief A three pass, block based, segmented inclusive scan.
+ */
+struct scan_by_key_impl {
+  /**
+   * @brief Reduce each block's trailing segment, propagate the carries serially then rescan each block.
+   *
+   * Every element is read before its output is written hence `out` may equal `beg`.
+   */
+  template <std::random_access_iterator I,
+            head_flag_iterator F,
+            std::random_access_iterator O,
+            class Bop,
+            class Proj>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I beg,
+                                 std::ptrdiff_t len,
+                                 F flags,
+                                 O out,
+                                 std::ptrdiff_t n,
+                                 Bop bop,
+                                 Proj proj) LF_STATIC_CONST->lf::task<> {
+
+    using acc_t = std::iter_value_t<O>;
+
+    LF_ASSERT(n > 0);
+    LF_ASSERT(len >= 0);
+
+    std::ptrdiff_t chunks = (len + n - 1) / n;
+
+    // Fold the elements of [lo, hi) into `acc`, restarting at every head flag.
+    auto fold = [=](std::optional<acc_t> &acc, std::ptrdiff_t lo, std::ptrdiff_t hi, auto &&write) mutable {
+      for (std::ptrdiff_t i = lo; i < hi; ++i) {
+
+        auto &&elem = std::invoke(proj, beg[i]);
+
+        if (!acc || static_cast<bool>(flags[i])) {
+          acc.emplace(std::forward<decltype(elem)>(elem));
+        } else {
+          *acc = std::invoke(bop, std::move(*acc), std::forward<decltype(elem)>(elem));
+        }
+
+        write(i, *acc);
+      }
+    };
+
+    // `carry[k + 1]` is the value of the trailing segment of block `k` and whether that segment started
+    // inside the block, after the serial pass `carry[k]` is the value carried into block `k`.
+
+    std::vector<std::optional<acc_t>> carry(static_cast<std::size_t>(chunks));
+    std::vector<char> reset(static_cast<std::size_t>(chunks), 0);
+
+    if (chunks > 1) {
+      co_await lf::call(for_leaves{})(0, chunks - 1, [=, &carry, &reset](std::ptrdiff_t k) mutable {
+        std::ptrdiff_t lo = k * n;
+
+        std::optional<acc_t> acc;
+
+        fold(acc, lo, lo + n, [](std::ptrdiff_t, acc_t const &) {});
+
+        bool head = std::any_of(flags + lo, flags + lo + n, [](auto &&flag) {
+          return static_cast<bool>(flag);
+        });
+
+        carry[static_cast<std::size_t>(k + 1)] = std::move(acc);
+        reset[static_cast<std::size_t>(k + 1)] = head ? 1 : 0;
+      });
+      co_await lf::join;
+    }
+
+    for (std::size_t k = 2; k < carry.size(); ++k) {
+      if (reset[k] == 0) {
+        *carry[k] = std::invoke(bop, *carry[k - 1], std::move(*carry[k]));
+      }
+    }
+
+    co_await lf::call(for_leaves{})(0, chunks, [=, &carry](std::ptrdiff_t k) mutable {
+      std::optional<acc_t> acc = std::move(carry[static_cast<std::size_t>(k)]);
+
+      fold(acc, k * n, std::min(k * n + n, len), [out](std::ptrdiff_t i, acc_t const &val) {
+        out[i] = val;
+      });
+    });
+
+    co_await lf::join;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief Eight overloads of scan_by_key for (iterator/range, chunk/in_place, n = 4096/n != 4096).
+ */
+struct scan_by_key_overload {
+  /**
+   * @brief [iterator,chunk,output] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            head_flag_iterator F,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, I, Proj> Bop>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 I beg,
+                                 S end,
+                                 F flags,
+                                 O out,
+                                 std::iter_difference_t<I> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(beg, end - beg, flags, out, n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,n = 4096,output] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            head_flag_iterator F,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, I, Proj> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I beg, S end, F flags, O out, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(
+        beg, end - beg, flags, out, detail::k_scan_grain, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,chunk,in_place] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            head_flag_iterator F,
+            class Proj = std::identity,
+            regular_scannable<I, I, Proj> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I beg, S end, F flags, std::iter_difference_t<I> n, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(beg, end - beg, flags, beg, n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [iterator,n = 4096,in_place] version.
+   */
+  template <std::random_access_iterator I,
+            std::sized_sentinel_for<I> S,
+            head_flag_iterator F,
+            class Proj = std::identity,
+            regular_scannable<I, I, Proj> Bop>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, I beg, S end, F flags, Bop bop, Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(
+        beg, end - beg, flags, beg, detail::k_scan_grain, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,chunk,output] version.
+   */
+  template <std::ranges::random_access_range R,
+            head_flag_iterator F,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 F flags,
+                                 O out,
+                                 std::ranges::range_difference_t<R> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(
+        std::ranges::begin(range), std::ranges::ssize(range), flags, out, n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,n = 4096,output] version.
+   */
+  template <std::ranges::random_access_range R,
+            head_flag_iterator F,
+            std::random_access_iterator O,
+            class Proj = std::identity,
+            regular_scannable<O, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, F flags, O out, Bop bop, Proj proj = {})
+      LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(
+        std::ranges::begin(range), std::ranges::ssize(range), flags, out, detail::k_scan_grain, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,chunk,in_place] version.
+   */
+  template <std::ranges::random_access_range R,
+            head_flag_iterator F,
+            class Proj = std::identity,
+            regular_scannable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto operator()(auto /* unused */,
+                                 R &&range,
+                                 F flags,
+                                 std::ranges::range_difference_t<R> n,
+                                 Bop bop,
+                                 Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(
+        std::ranges::begin(range), std::ranges::ssize(range), flags, std::ranges::begin(range), n, bop, proj);
+    co_await lf::join;
+  }
+  /**
+   * @brief [range,n = 4096,in_place] version.
+   */
+  template <std::ranges::random_access_range R,
+            head_flag_iterator F,
+            class Proj = std::identity,
+            regular_scannable<std::ranges::iterator_t<R>, std::ranges::iterator_t<R>, Proj> Bop>
+    requires std::ranges::sized_range<R>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, R &&range, F flags, Bop bop, Proj proj = {}) LF_STATIC_CONST->lf::task<> {
+    co_await lf::call(detail::scan_by_key_impl{})(std::ranges::begin(range),
+                                                  std::ranges::ssize(range),
+                                                  flags,
+                                                  std::ranges::begin(range),
+                                                  detail::k_scan_grain,
+                                                  bop,
+                                                  proj);
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+/**
+ * @brief A parallel segmented inclusive scan, which restarts at every head flag.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <std::random_access_iterator I,
+ *              std::sized_sentinel_for<I> S,
+ *              head_flag_iterator F,
+ *              std::random_access_iterator O,
+ *              class Proj = std::identity,
+ *              regular_scannable<O, I, Proj> Bop
+ *              >
+ *    void scan_by_key(I beg, S end, F flags, O out, std::iter_difference_t<I> n, Bop bop, Proj proj = {});
+ *
+ * Overloads exist for a random-access range (instead of ``head`` and ``tail``), in place scans (omit the
+ * `out` iterator) and, the chunk size, ``n``, can be omitted (which will set ``n = 4096``).
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[scan_by_key](fields, record_starts.begin(), std::plus<>{});
+ *
+ * \endrst
+ *
+ * The input is partitioned into segments, a new segment starts at every element ``i`` for which
+ * ``flags[i]`` is true (and at the first element). This computes the inclusive scan of each segment
+ * independently, e.g. with flags `[1, 0, 0, 1, 0]` the input `[1, 2, 2, 1, 3] -> [1, 3, 5, 1, 4]`.
+ *
+ * The input and output ranges must either be distinct (i.e. non-overlapping) or the same range. As with
+ * ``lf::exclusive_scan`` the work is split into chunks of ``n`` elements and the binary operator and
+ * projection must be regular (non-async) functions.
+ */
+inline constexpr impl::scan_by_key_overload scan_by_key = {};
+
+} // namespace lf
+
+#endif /* C19F6B3E_7A54_4D28_9E0B_2F8D4A6C1E73 */
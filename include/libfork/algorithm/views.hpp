@@ -0,0 +1,346 @@
+#ifndef B4C81F26_5E07_4A93_9D6B_0E2F3A7C58D1
+#define B4C81F26_5E07_4A93_9D6B_0E2F3A7C58D1
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>    // for copy_constructible, regular_invocable, predicate, copyable
+#include <functional>  // for invoke
+#include <optional>    // for optional, nullopt
+#include <ranges>      // for all_t, view, random_access_range, sized_range, viewable_range
+#include <tuple>       // for tuple, tuple_cat, make_from_tuple
+#include <type_traits> // for remove_cvref_t, decay_t, invoke_result_t, false_type, true_type
+#include <utility>     // for forward, move, as_const
+
+#include "libfork/core/macro.hpp" // for LF_STATIC_CALL, LF_STATIC_CONST
+
+/**
+ * @file views.hpp
+ *
+ * @brief Range adaptors that the algorithms fuse into a single pass over memory.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief A pipeline stage that transforms each element.
+ */
+template <std::copy_constructible F>
+struct transform_stage {
+  /**
+   * @brief The transformation.
+   */
+  F fun;
+};
+
+/**
+ * @brief A pipeline stage that drops elements which do not satisfy a predicate.
+ */
+template <std::copy_constructible P>
+struct filter_stage {
+  /**
+   * @brief The predicate.
+   */
+  P pred;
+};
+
+namespace detail {
+
+template <typename>
+struct is_filter : std::false_type {};
+
+template <typename P>
+struct is_filter<filter_stage<P>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Compose a sequence of stages into one (regular) projection.
+ *
+ * If `Opt` is `true` the projection returns a `std::optional`, which is empty if any filter rejects the
+ * element.
+ */
+template <bool Opt, typename... Stages>
+struct pipeline;
+
+/**
+ * @brief The end of a pipeline.
+ */
+template <bool Opt>
+struct pipeline<Opt> {
+  /**
+   * @brief Yield the (possibly wrapped) value.
+   */
+  template <typename T>
+  constexpr auto operator()(T &&val) const
+      -> std::conditional_t<Opt, std::optional<std::remove_cvref_t<T>>, T> {
+    return std::forward<T>(val);
+  }
+};
+
+/**
+ * @brief A transform stage of a pipeline.
+ */
+template <bool Opt, typename F, typename... Rest>
+struct pipeline<Opt, transform_stage<F>, Rest...> {
+  /**
+   * @brief Construct from a flat list of stages.
+   */
+  constexpr explicit pipeline(transform_stage<F> head, Rest... rest)
+      : fun{std::move(head.fun)},
+        next{std::move(rest)...} {}
+
+  /**
+   * @brief Transform `val` and forward it to the rest of the pipeline.
+   */
+  template <typename T>
+    requires std::regular_invocable<F const &, T>
+  constexpr auto operator()(T &&val) const -> decltype(auto) {
+    return next(std::invoke(fun, std::forward<T>(val)));
+  }
+
+  /**
+   * @brief The transformation.
+   */
+  F fun;
+  /**
+   * @brief The rest of the pipeline.
+   */
+  pipeline<Opt, Rest...> next;
+};
+
+/**
+ * @brief A filter stage of a pipeline.
+ */
+template <typename P, typename... Rest>
+struct pipeline<true, filter_stage<P>, Rest...> {
+  /**
+   * @brief Construct from a flat list of stages.
+   */
+  constexpr explicit pipeline(filter_stage<P> head, Rest... rest)
+      : pred{std::move(head.pred)},
+        next{std::move(rest)...} {}
+
+  /**
+   * @brief Forward `val` to the rest of the pipeline if it satisfies the predicate.
+   */
+  template <typename T>
+    requires std::predicate<P const &, std::remove_reference_t<T> const &>
+  constexpr auto operator()(T &&val) const
+      -> std::invoke_result_t<pipeline<true, Rest...> const &, T> {
+    if (!std::invoke(pred, std::as_const(val))) {
+      return std::nullopt;
+    }
+    return next(std::forward<T>(val));
+  }
+
+  /**
+   * @brief The predicate.
+   */
+  P pred;
+  /**
+   * @brief The rest of the pipeline.
+   */
+  pipeline<true, Rest...> next;
+};
+
+/**
+ * @brief The projection equivalent to a sequence of stages.
+ */
+template <typename... Stages>
+using fused_projection = pipeline<(detail::is_filter<Stages>::value || ...), Stages...>;
+
+/**
+ * @brief Lift a binary operation to skip empty optionals.
+ *
+ * This turns a semigroup over `T` into a monoid over `std::optional<T>` with identity `std::nullopt`, it
+ * is how filters are fused into a reduction.
+ */
+template <std::copy_constructible Bop>
+struct skip_empty {
+  /**
+   * @brief Combine the engaged operands.
+   */
+  template <typename A,
+            typename B,
+            typename L = decltype(*std::declval<A>()),
+            typename R = decltype(*std::declval<B>())>
+    requires std::regular_invocable<Bop const &, L, R>
+  constexpr auto
+  operator()(A &&lhs, B &&rhs) const -> std::optional<std::decay_t<std::invoke_result_t<Bop const &, L, R>>> {
+
+    if (!lhs) {
+      if (!rhs) {
+        return std::nullopt;
+      }
+      return *std::forward<B>(rhs);
+    }
+
+    if (!rhs) {
+      return *std::forward<A>(lhs);
+    }
+
+    return std::invoke(bop, *std::forward<A>(lhs), *std::forward<B>(rhs));
+  }
+
+  /**
+   * @brief The underlying operation.
+   */
+  Bop bop;
+};
+
+/**
+ * @brief A random access range with a sequence of stages that are applied lazily by the algorithms.
+ *
+ * This is not itself a range, it is consumed by the overloads of `lf::fold` and `lf::scan` that execute
+ * the whole pipeline as a single task tree.
+ */
+template <std::ranges::view V, typename... Stages>
+  requires std::ranges::random_access_range<V> && std::ranges::sized_range<V>
+class fused_view {
+ public:
+  /**
+   * @brief `true` if any stage is a filter.
+   */
+  static constexpr bool filtered = (detail::is_filter<Stages>::value || ...);
+
+  /**
+   * @brief Construct from the underlying view and the stages.
+   */
+  constexpr fused_view(V base, std::tuple<Stages...> stages)
+      : m_base{std::move(base)},
+        m_stages{std::move(stages)} {}
+
+  /**
+   * @brief Get the underlying view.
+   */
+  [[nodiscard]] constexpr auto base() noexcept -> V & { return m_base; }
+
+  /**
+   * @brief Get the stages.
+   */
+  [[nodiscard]] constexpr auto stages() const noexcept -> std::tuple<Stages...> const & { return m_stages; }
+
+  /**
+   * @brief Get the projection that applies every stage.
+   */
+  [[nodiscard]] constexpr auto projection() const -> fused_projection<Stages...> {
+    return std::make_from_tuple<fused_projection<Stages...>>(m_stages);
+  }
+
+ private:
+  V m_base;
+  std::tuple<Stages...> m_stages;
+};
+
+/**
+ * @brief Test if `T` is a specialization of `fused_view`.
+ */
+template <typename T>
+inline constexpr bool is_fused_view = false;
+
+/**
+ * @brief Test if `T` is a specialization of `fused_view`.
+ */
+template <typename V, typename... Stages>
+inline constexpr bool is_fused_view<fused_view<V, Stages...>> = true;
+
+/**
+ * @brief A range adaptor closure holding a single stage.
+ */
+template <typename Stage>
+struct view_closure {
+  /**
+   * @brief The stage to append.
+   */
+  Stage stage;
+
+  /**
+   * @brief Begin a pipeline.
+   */
+  template <std::ranges::viewable_range R>
+    requires std::ranges::random_access_range<R> && std::ranges::sized_range<R> &&
+             std::copyable<std::views::all_t<R>>
+  friend constexpr auto operator|(R &&range, view_closure self) -> fused_view<std::views::all_t<R>, Stage> {
+    return {std::views::all(std::forward<R>(range)), std::tuple<Stage>{std::move(self.stage)}};
+  }
+
+  /**
+   * @brief Append a stage to a pipeline.
+   */
+  template <typename V, typename... Stages>
+  friend constexpr auto operator|(fused_view<V, Stages...> view, view_closure self)
+      -> fused_view<V, Stages..., Stage> {
+    return {view.base(), std::tuple_cat(view.stages(), std::tuple<Stage>{std::move(self.stage)})};
+  }
+};
+
+/**
+ * @brief Function object for `lf::views::transform`.
+ */
+struct transform_fn {
+  /**
+   * @brief Make a transform closure.
+   */
+  template <std::copy_constructible F>
+  LF_STATIC_CALL constexpr auto operator()(F fun) LF_STATIC_CONST->view_closure<transform_stage<F>> {
+    return {{std::move(fun)}};
+  }
+};
+
+/**
+ * @brief Function object for `lf::views::filter`.
+ */
+struct filter_fn {
+  /**
+   * @brief Make a filter closure.
+   */
+  template <std::copy_constructible P>
+  LF_STATIC_CALL constexpr auto operator()(P pred) LF_STATIC_CONST->view_closure<filter_stage<P>> {
+    return {{std::move(pred)}};
+  }
+};
+
+} // namespace impl
+
+namespace views {
+
+/**
+ * @brief A range adaptor that transforms each element, fused into the consuming algorithm.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    co_await just[fold](v | views::transform(square) | views::filter(is_even), std::plus<>{});
+ *
+ * \endrst
+ *
+ * Unlike ``std::views::transform`` the resulting object is not a range, it can only be consumed by
+ * ``lf::fold`` and ``lf::scan``, which apply every stage as part of a single task tree. The function
+ * must be a regular (not async) function.
+ */
+inline constexpr impl::transform_fn transform = {};
+
+/**
+ * @brief A range adaptor that drops elements which do not satisfy a predicate, fused into `lf::fold`.
+ *
+ * The predicate must be a regular (not async) function. A filtered pipeline can be folded (the operation
+ * must be a regular function) but not scanned.
+ */
+inline constexpr impl::filter_fn filter = {};
+
+} // namespace views
+
+} // namespace lf
+
+#endif /* B4C81F26_5E07_4A93_9D6B_0E2F3A7C58D1 */
@@ -9,6 +9,8 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include "libfork/core/aggregate_exception.hpp"
+#include "libfork/core/channel.hpp"
 #include "libfork/core/co_alloc.hpp"
 #include "libfork/core/control_flow.hpp"
 #include "libfork/core/defer.hpp"
@@ -16,13 +18,17 @@
 #include "libfork/core/exceptions.hpp"
 #include "libfork/core/extern.hpp"
 #include "libfork/core/first_arg.hpp"
+#include "libfork/core/generator.hpp"
 #include "libfork/core/invocable.hpp"
 #include "libfork/core/just.hpp"
 #include "libfork/core/macro.hpp"
 #include "libfork/core/scheduler.hpp"
+#include "libfork/core/semaphore.hpp"
 #include "libfork/core/sync_wait.hpp"
 #include "libfork/core/tag.hpp"
 #include "libfork/core/task.hpp"
+#include "libfork/core/task_group.hpp"
+#include "libfork/core/when_all.hpp"
 
 #include "libfork/core/ext/context.hpp"
 #include "libfork/core/ext/deque.hpp"
@@ -38,9 +44,11 @@
 #include "libfork/core/impl/promise.hpp"
 #include "libfork/core/impl/return.hpp"
 #include "libfork/core/impl/safe_ref.hpp"
+#include "libfork/core/impl/spin_lock.hpp"
 #include "libfork/core/impl/stack.hpp"
 #include "libfork/core/impl/unique_frame.hpp"
 #include "libfork/core/impl/utility.hpp"
+#include "libfork/core/impl/waiter.hpp"
 
 /**
  * @file core.hpp
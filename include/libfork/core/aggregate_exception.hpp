@@ -0,0 +1,65 @@
+#ifndef B3A1D6E4_2F7C_4E59_9C0A_5D8E41F7A263
+#define B3A1D6E4_2F7C_4E59_9C0A_5D8E41F7A263
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <exception> // for exception, exception_ptr
+#include <span>      // for span
+#include <utility>   // for move
+#include <vector>    // for vector
+
+/**
+ * @file aggregate_exception.hpp
+ *
+ * @brief An exception that carries every exception thrown by the children of a join.
+ */
+
+namespace lf {
+
+inline namespace core {
+
+/**
+ * @brief Thrown by a join when more than one child threw an exception.
+ *
+ * Only thrown if libfork is compiled with ``LF_AGGREGATE_EXCEPTIONS`` defined, otherwise a join rethrows
+ * the first exception and the rest are discarded. A join at which only one child threw rethrows that
+ * exception unchanged in either mode.
+ */
+class aggregate_exception : public std::exception {
+ public:
+  /**
+   * @brief Construct an aggregate from the exceptions of the children, in no particular order.
+   */
+  explicit aggregate_exception(std::vector<std::exception_ptr> exceptions) noexcept
+      : m_exceptions{std::move(exceptions)} {}
+
+  /**
+   * @brief A diagnostic message.
+   */
+  auto what() const noexcept -> char const * override { return "Multiple children threw exceptions!"; }
+
+  /**
+   * @brief Get the exceptions thrown by the children.
+   */
+  [[nodiscard]] auto exceptions() const noexcept -> std::span<std::exception_ptr const> {
+    return m_exceptions;
+  }
+
+ private:
+  /**
+   * @brief The exceptions thrown by the children.
+   */
+  std::vector<std::exception_ptr> m_exceptions;
+};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* B3A1D6E4_2F7C_4E59_9C0A_5D8E41F7A263 */
@@ -0,0 +1,341 @@
+#ifndef F8336944_B9EC_4C25_A719_B31A2539AED3
+#define F8336944_B9EC_4C25_A719_B31A2539AED3
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <cstddef>     // for size_t
+#include <mutex>       // for lock_guard
+#include <optional>    // for optional, nullopt
+#include <type_traits> // for is_nothrow_move_constructible_v, is_nothrow_move_assignable_v
+#include <utility>     // for move
+#include <vector>      // for vector
+
+#include "libfork/core/ext/handles.hpp"    // for submit_handle
+#include "libfork/core/impl/spin_lock.hpp" // for spin_lock
+#include "libfork/core/impl/utility.hpp"   // for immovable
+#include "libfork/core/impl/waiter.hpp"    // for waiter, waiter_queue
+#include "libfork/core/macro.hpp"          // for LF_ASSERT
+#include "libfork/core/scheduler.hpp"      // for context_switcher
+
+/**
+ * @file channel.hpp
+ *
+ * @brief A bounded multi-producer, multi-consumer channel for communicating between tasks.
+ */
+
+namespace lf {
+
+inline namespace core {
+
+/**
+ * @brief A bounded multi-producer, multi-consumer channel.
+ *
+ * Both `send()` and `recv()` return ``lf::core::context_switcher`` awaitables, if the operation
+ * cannot complete immediately the awaiting coroutine (not the thread) is suspended. When the operation
+ * completes the coroutine is re-submitted to the worker it suspended on via the worker's
+ * `schedule()`. A channel with a capacity of zero is a rendezvous channel.
+ *
+ * \rst
+ *
+ * .. note::
+ *
+ *    All coroutines suspended on a channel must be woken (e.g. by calling ``close()``) before the
+ *    channel is destroyed.
+ *
+ * .. note::
+ *
+ *    The channel is not lock-free, the buffer and the lists of suspended coroutines are guarded by a
+ *    single spin lock which is held for a handful of instructions per ``send()``/``recv()``. This keeps
+ *    the hand-off between a buffered value and a suspended peer atomic, under heavy contention from
+ *    many producers and consumers a lock-free queue of values may scale better.
+ *
+ * \endrst
+ */
+template <typename T>
+  requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+class channel : impl::immovable<channel<T>> {
+
+  class send_awaitable;
+  class recv_awaitable;
+
+ public:
+  /**
+   * @brief The type of the values transmitted through this channel.
+   */
+  using value_type = T;
+
+  /**
+   * @brief Construct a channel that can buffer up to `capacity` values.
+   */
+  explicit channel(std::size_t capacity) : m_buf(capacity) {}
+
+  /**
+   * @brief Destroy the channel, no coroutines may be suspended on it.
+   */
+  ~channel() noexcept {
+    LF_ASSERT(m_senders.empty());
+    LF_ASSERT(m_receivers.empty());
+  }
+
+  /**
+   * @brief The maximum number of buffered values.
+   */
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_buf.size(); }
+
+  /**
+   * @brief Send a value through the channel.
+   *
+   * Awaiting the result yields `true` if the value was delivered or `false` if the channel was closed.
+   */
+  [[nodiscard]] auto send(T value) noexcept -> send_awaitable {
+    return send_awaitable{this, std::move(value)};
+  }
+
+  /**
+   * @brief Receive a value from the channel.
+   *
+   * Awaiting the result yields the value or `std::nullopt` if the channel is closed and empty.
+   */
+  [[nodiscard]] auto recv() noexcept -> recv_awaitable { return recv_awaitable{this}; }
+
+  /**
+   * @brief Close the channel.
+   *
+   * Suspended senders are woken and fail, future sends fail. Receivers can drain any buffered
+   * values after which they receive `std::nullopt`.
+   */
+  void close() noexcept {
+
+    impl::waiter_queue<send_awaitable> senders;
+    impl::waiter_queue<recv_awaitable> receivers;
+
+    {
+      std::lock_guard lock{m_lock};
+      m_closed = true;
+      senders = m_senders.take();
+      receivers = m_receivers.take();
+    }
+
+    while (send_awaitable *sender = senders.pop()) {
+      sender->wake();
+    }
+
+    while (recv_awaitable *receiver = receivers.pop()) {
+      receiver->wake();
+    }
+  }
+
+ private:
+  /**
+   * @brief The awaitable returned by `send()`.
+   */
+  class [[nodiscard("This should be immediately co_awaited")]] send_awaitable : public impl::waiter {
+   public:
+    /**
+     * @brief Attempt to send without suspending.
+     */
+    auto await_ready() noexcept -> bool {
+
+      impl::waiter *other = nullptr;
+
+      bool ready = [&] {
+        std::lock_guard lock{m_chan->m_lock};
+        return m_chan->try_send(*this, other);
+      }();
+
+      if (other != nullptr) {
+        other->wake();
+      }
+
+      return ready;
+    }
+
+    /**
+     * @brief Park this coroutine until a receiver (or `close()`) wakes it.
+     */
+    void await_suspend(submit_handle handle) noexcept {
+
+      prime(handle);
+
+      impl::waiter *other = nullptr;
+
+      bool ready = [&] {
+        std::lock_guard lock{m_chan->m_lock};
+        if (m_chan->try_send(*this, other)) {
+          return true;
+        }
+        m_chan->m_senders.push(this);
+        return false;
+      }();
+
+      // If enqueued we may already have been woken, cannot touch `this`.
+
+      if (ready) {
+        if (other != nullptr) {
+          other->wake();
+        }
+        wake();
+      }
+    }
+
+    /**
+     * @brief Returns `true` if the value was sent.
+     */
+    [[nodiscard]] auto await_resume() const noexcept -> bool { return m_sent; }
+
+   private:
+    friend class channel;
+
+    send_awaitable(channel *chan, T &&value) noexcept : m_chan{chan}, m_value{std::move(value)} {}
+
+    channel *m_chan;
+    T m_value;
+    bool m_sent = false;
+  };
+
+  /**
+   * @brief The awaitable returned by `recv()`.
+   */
+  class [[nodiscard("This should be immediately co_awaited")]] recv_awaitable : public impl::waiter {
+   public:
+    /**
+     * @brief Attempt to receive without suspending.
+     */
+    auto await_ready() noexcept -> bool {
+
+      impl::waiter *other = nullptr;
+
+      bool ready = [&] {
+        std::lock_guard lock{m_chan->m_lock};
+        return m_chan->try_recv(*this, other);
+      }();
+
+      if (other != nullptr) {
+        other->wake();
+      }
+
+      return ready;
+    }
+
+    /**
+     * @brief Park this coroutine until a sender (or `close()`) wakes it.
+     */
+    void await_suspend(submit_handle handle) noexcept {
+
+      prime(handle);
+
+      impl::waiter *other = nullptr;
+
+      bool ready = [&] {
+        std::lock_guard lock{m_chan->m_lock};
+        if (m_chan->try_recv(*this, other)) {
+          return true;
+        }
+        m_chan->m_receivers.push(this);
+        return false;
+      }();
+
+      // If enqueued we may already have been woken, cannot touch `this`.
+
+      if (ready) {
+        if (other != nullptr) {
+          other->wake();
+        }
+        wake();
+      }
+    }
+
+    /**
+     * @brief Returns the received value or `std::nullopt` if the channel was closed.
+     */
+    [[nodiscard]] auto await_resume() noexcept -> std::optional<T> { return std::move(m_value); }
+
+   private:
+    friend class channel;
+
+    explicit recv_awaitable(channel *chan) noexcept : m_chan{chan} {}
+
+    channel *m_chan;
+    std::optional<T> m_value;
+  };
+
+  /**
+   * @brief Try to complete a send, requires the lock. Sets `other` if a receiver must be woken.
+   */
+  auto try_send(send_awaitable &self, impl::waiter *&other) noexcept -> bool {
+
+    if (m_closed) {
+      self.m_sent = false;
+      return true;
+    }
+
+    if (recv_awaitable *receiver = m_receivers.pop()) {
+      LF_ASSERT(m_size == 0);
+      receiver->m_value.emplace(std::move(self.m_value));
+      other = receiver;
+    } else if (m_size < m_buf.size()) {
+      m_buf[(m_head + m_size++) % m_buf.size()].emplace(std::move(self.m_value));
+    } else {
+      return false;
+    }
+
+    self.m_sent = true;
+    return true;
+  }
+
+  /**
+   * @brief Try to complete a receive, requires the lock. Sets `other` if a sender must be woken.
+   */
+  auto try_recv(recv_awaitable &self, impl::waiter *&other) noexcept -> bool {
+
+    if (m_size > 0) {
+
+      std::optional<T> &front = m_buf[m_head];
+
+      self.m_value.emplace(std::move(*front));
+      front.reset();
+
+      m_head = (m_head + 1) % m_buf.size();
+      m_size -= 1;
+
+      // A slot has become free, a blocked sender can fill it.
+      if (send_awaitable *sender = m_senders.pop()) {
+        m_buf[(m_head + m_size++) % m_buf.size()].emplace(std::move(sender->m_value));
+        sender->m_sent = true;
+        other = sender;
+      }
+
+      return true;
+    }
+
+    // Rendezvous directly with a blocked sender.
+    if (send_awaitable *sender = m_senders.pop()) {
+      self.m_value.emplace(std::move(sender->m_value));
+      sender->m_sent = true;
+      other = sender;
+      return true;
+    }
+
+    return m_closed;
+  }
+
+  impl::spin_lock m_lock;
+  std::vector<std::optional<T>> m_buf;
+  std::size_t m_head = 0;
+  std::size_t m_size = 0;
+  bool m_closed = false;
+  impl::waiter_queue<send_awaitable> m_senders;
+  impl::waiter_queue<recv_awaitable> m_receivers;
+};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* F8336944_B9EC_4C25_A719_B31A2539AED3 */
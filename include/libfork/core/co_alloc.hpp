@@ -15,10 +15,11 @@
 #include <span>        // for span
 #include <type_traits> // for integral_constant, type_identity
 
-#include "libfork/core/ext/tls.hpp"      // for stack
-#include "libfork/core/impl/frame.hpp"   // for frame
-#include "libfork/core/impl/stack.hpp"   // for stack
-#include "libfork/core/impl/utility.hpp" // for immovable, k_new_align
+#include "libfork/core/ext/tls.hpp"        // for stack
+#include "libfork/core/impl/frame.hpp"     // for frame
+#include "libfork/core/impl/heap_pool.hpp" // for thread_heap_pool
+#include "libfork/core/impl/stack.hpp"     // for stack
+#include "libfork/core/impl/utility.hpp"   // for immovable, k_new_align
 
 /**
  * @file co_alloc.hpp
@@ -26,22 +27,45 @@
  * @brief Expert-only utilities to interact with a coroutines stack.
  */
 
+#ifndef LF_CO_NEW_HEAP_THRESHOLD
+  /**
+   * @brief Allocations (in bytes) by ``co_new`` larger than this are made on the heap.
+   *
+   * This stops a large temporary buffer from permanently growing a worker's stack.
+   */
+  #define LF_CO_NEW_HEAP_THRESHOLD 65536
+#endif
+
 namespace lf {
 
 inline namespace core {
 
 /**
- * @brief Check is a type is suitable for allocation on libfork's stacks.
+ * @brief Check is a type is suitable for allocation with ``lf::core::co_new``.
  *
- * This requires the type to be `std::default_initializable<T>` and have non-new-extended alignment.
+ * This requires the type to be `std::default_initializable<T>`, types with new-extended alignment are
+ * allocated on the heap.
  */
 template <typename T>
-concept co_allocable = std::default_initializable<T> && alignof(T) <= impl::k_new_align;
+concept co_allocable = std::default_initializable<T>;
 
 } // namespace core
 
 namespace impl {
 
+/**
+ * @brief Allocations by ``co_new`` larger than this many bytes are made on the heap.
+ */
+inline constexpr std::size_t k_co_new_heap_threshold = LF_CO_NEW_HEAP_THRESHOLD;
+
+/**
+ * @brief Test if `count` objects of type `T` should be allocated on the heap instead of the stack.
+ */
+template <typename T>
+constexpr auto co_new_on_heap(std::size_t count) noexcept -> bool {
+  return alignof(T) > k_new_align || count > k_co_new_heap_threshold / sizeof(T);
+}
+
 /**
  * @brief An awaitable (in the context of an ``lf::task``) which triggers stack allocation.
  */
@@ -60,14 +84,15 @@ inline namespace core {
 /**
  * @brief The result of `co_await`ing the result of ``lf::core::co_new``.
  *
- * A raii wrapper around a ``std::span`` pointing to the memory allocated on the stack.
- * This type can be destructured into a ``std::span`` to the allocated memory.
+ * A raii wrapper around a ``std::span`` pointing to the memory allocated on the stack (or the heap for
+ * large/over-aligned allocations). This type can be destructured into a ``std::span`` to the allocated
+ * memory.
  */
 template <co_allocable T>
 class stack_allocated : impl::immovable<stack_allocated<T>> {
  public:
   /**
-   * @brief Construct a new co allocated object.
+   * @brief Construct a new co allocated object, `frame` is null if the memory is on the heap.
    */
   stack_allocated(impl::frame *frame, std::span<T> span) noexcept : m_frame{frame}, m_span{span} {}
 
@@ -93,8 +118,15 @@ class stack_allocated : impl::immovable<stack_allocated<T>> {
    * @brief Destroys objects and releases the memory.
    */
   ~stack_allocated() noexcept {
-    LF_ASSERT(m_frame->stacklet() == impl::tls::stack()->top());
+
     std::ranges::destroy(m_span);
+
+    if (m_frame == nullptr) {
+      impl::thread_heap_pool().deallocate(m_span.data(), m_span.size_bytes(), alignof(T));
+      return;
+    }
+
+    LF_ASSERT(m_frame->stacklet() == impl::tls::stack()->top());
     auto *stack = impl::tls::stack();
     stack->deallocate(m_span.data());
     m_frame->reset_stacklet(stack->top());
@@ -134,6 +166,9 @@ inline namespace core {
  *
  * Upon ``co_await``ing the result of this function an ``lf::stack_allocated`` object is returned.
  *
+ * Allocations larger than ``LF_CO_NEW_HEAP_THRESHOLD`` bytes, or of types with new-extended alignment
+ * (e.g. SIMD vectors), are transparently made from a per-thread, size-class pooled heap allocator instead.
+ *
  * \rst
  *
  * .. warning::
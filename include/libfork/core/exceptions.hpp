@@ -11,7 +11,8 @@
 
 #include <exception> // for exception
 
-#include "libfork/core/first_arg.hpp" // for quasi_pointer
+#include "libfork/core/aggregate_exception.hpp" // for aggregate_exception
+#include "libfork/core/first_arg.hpp"           // for quasi_pointer
 
 /**
  * @file exceptions.hpp
@@ -9,6 +9,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <atomic>     // for atomic, memory_order_relaxed
 #include <functional> // for function
 #include <utility>    // for move
 #include <version>    // for __cpp_lib_move_only_function
@@ -89,6 +90,33 @@ class worker_context : impl::immovable<context> {
    */
   [[nodiscard]] auto try_steal() noexcept -> steal_t<task_handle> { return m_tasks.steal(); }
 
+  /**
+   * @brief Record that `thief` has stolen a task from this context, supports concurrent calls.
+   *
+   * Schedulers can use this to implement leapfrogging, see ``last_thief()``.
+   */
+  void set_last_thief(worker_context *thief) noexcept { m_thief.store(thief, std::memory_order_relaxed); }
+
+  /**
+   * @brief Get the context that most recently stole from this context, or `nullptr`.
+   *
+   * A worker's task deque only contains the continuations of its own tasks hence, the last thief is
+   * executing (an ancestor of) this worker's work. A worker that runs out of work, for example because it
+   * lost a join race, can steal back from the thief to stay within its own subtree.
+   */
+  [[nodiscard]] auto last_thief() const noexcept -> worker_context * {
+    return m_thief.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Forget `thief` if it is still the last thief, supports concurrent calls.
+   *
+   * Schedulers should call this once the thief's deque has run empty, a newer thief is never cleared.
+   */
+  void clear_last_thief(worker_context *thief) noexcept {
+    m_thief.compare_exchange_strong(thief, nullptr, std::memory_order_relaxed);
+  }
+
  private:
   friend class impl::full_context;
 
@@ -114,6 +142,10 @@ class worker_context : impl::immovable<context> {
    * @brief The user supplied notification function.
    */
   nullary_function_t m_notify;
+  /**
+   * @brief The context that most recently stole from this context.
+   */
+  std::atomic<worker_context *> m_thief = nullptr;
 };
 
 } // namespace ext
@@ -0,0 +1,208 @@
+#ifndef FFD3778A_74E9_47B8_A5A5_ABE0069C1D7D
+#define FFD3778A_74E9_47B8_A5A5_ABE0069C1D7D
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <cstddef>     // for size_t
+#include <type_traits> // for is_nothrow_move_constructible_v, is_nothrow_move_assignable_v, remove_cvref_t
+#include <utility>     // for forward, move
+
+#include "libfork/core/channel.hpp"        // for channel
+#include "libfork/core/control_flow.hpp"   // for join
+#include "libfork/core/defer.hpp"          // for LF_DEFER
+#include "libfork/core/first_arg.hpp"      // for async_function_object
+#include "libfork/core/impl/combinate.hpp" // for combinate
+#include "libfork/core/impl/utility.hpp"   // for immovable
+#include "libfork/core/invocable.hpp"      // for discard_t
+#include "libfork/core/tag.hpp"            // for tag, modifier
+#include "libfork/core/task.hpp"           // for task
+
+/**
+ * @file generator.hpp
+ *
+ * @brief An asynchronous generator, streams values from a (forking) producer task to a consumer task.
+ */
+
+namespace lf {
+
+inline namespace core {
+
+template <typename T>
+  requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+class async_generator;
+
+} // namespace core
+
+namespace impl {
+
+/**
+ * @brief Wraps a producer such that the generator is finished when the producer (and its children) return.
+ */
+template <typename T, async_function_object F>
+struct generate_fn {
+  /**
+   * @brief Call the producer with a sink then close the generator.
+   *
+   * The arguments are taken by value as this is forked.
+   */
+  template <typename... Args>
+  auto operator()(auto /* unused */, Args... args) const -> task<> {
+
+    LF_DEFER { gen->stop(); };
+
+    co_await combinate<tag::call, modifier::none>(discard_t{}, fun)(
+        gen->get_sink(), std::move(args)...
+    );
+    co_await lf::join;
+  }
+
+  /**
+   * @brief The producer.
+   */
+  [[no_unique_address]] F fun;
+  /**
+   * @brief The generator the producer yields to.
+   */
+  async_generator<T> *gen;
+};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief An asynchronous generator that streams values from a producer task to a consumer task.
+ *
+ * The producer is an ordinary async function, hence its frame and the frames of its children live on
+ * libfork's stacklets and it can fork internally. The producer receives a ``sink`` as its first
+ * (non-self) argument, sinks are cheap to copy and can be passed to forked children such that a
+ * whole fork-join tree can yield concurrently.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    using sink = lf::async_generator<record>::sink;
+ *
+ *    inline constexpr auto parse = [](auto, sink out, file &in) -> lf::task<> {
+ *      for (...) {
+ *        if (!co_await out.yield(std::move(rec))) {
+ *          co_return; // The consumer has stopped.
+ *        }
+ *      }
+ *    };
+ *
+ *    lf::async_generator<record> gen{64};
+ *
+ *    co_await gen.fork(parse)(std::ref(in));
+ *
+ *    while (std::optional<record> rec = co_await gen.next()) {
+ *      ...
+ *    }
+ *
+ *    co_await lf::join;
+ *
+ * .. note::
+ *
+ *    The generator is finished (and ``next()`` returns ``std::nullopt``) when the producer returns. A
+ *    consumer that stops early must call ``stop()`` before joining the producer, otherwise the producer
+ *    may be suspended forever in a ``yield``.
+ *
+ * \endrst
+ *
+ * Values are buffered in a bounded ``lf::channel``, a producer that gets ahead of the consumer is
+ * suspended (not the thread), this bounds the memory required for the stream. The generator must not be
+ * destroyed before the producer has been joined.
+ */
+template <typename T>
+  requires std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>
+class async_generator : impl::immovable<async_generator<T>> {
+ public:
+  /**
+   * @brief The type of the yielded values.
+   */
+  using value_type = T;
+
+  /**
+   * @brief A handle through which a producer yields values.
+   */
+  class sink {
+   public:
+    /**
+     * @brief Yield a value to the consumer.
+     *
+     * Awaiting the result yields `true` if the value was delivered or `false` if the generator has been
+     * stopped, in which case the producer should return.
+     */
+    [[nodiscard]] auto yield(T value) const noexcept { return m_gen->m_chan.send(std::move(value)); }
+
+   private:
+    friend class async_generator;
+
+    /**
+     * @brief Construct a sink for `gen`.
+     */
+    explicit sink(async_generator *gen) noexcept : m_gen{gen} {}
+
+    /**
+     * @brief The generator.
+     */
+    async_generator *m_gen;
+  };
+
+  /**
+   * @brief Construct a generator that buffers up to `capacity` values, zero is a rendezvous.
+   */
+  explicit async_generator(std::size_t capacity = 1) : m_chan{capacity} {}
+
+  /**
+   * @brief Get a new sink to this generator.
+   */
+  [[nodiscard]] auto get_sink() noexcept -> sink { return sink{this}; }
+
+  /**
+   * @brief Bind a producer to this generator, the result is awaitable like ``lf::fork(fun)``.
+   *
+   * The producer is invoked as `fun(self, sink, args...)` and the generator is stopped when it returns.
+   * Like ``std::thread`` the arguments are copied, use ``std::ref`` to pass a reference.
+   */
+  template <async_function_object F>
+  [[nodiscard]] auto fork(F &&fun) {
+    using gen_fn = impl::generate_fn<T, std::remove_cvref_t<F>>;
+    return impl::combinate<tag::fork, modifier::none>(impl::discard_t{}, gen_fn{std::forward<F>(fun), this});
+  }
+
+  /**
+   * @brief Get the next value.
+   *
+   * Awaiting the result yields the value or `std::nullopt` once the generator is finished.
+   */
+  [[nodiscard]] auto next() noexcept { return m_chan.recv(); }
+
+  /**
+   * @brief Stop the generator, pending and future yields fail.
+   *
+   * Values that have already been buffered can still be received with ``next()``.
+   */
+  void stop() noexcept { m_chan.close(); }
+
+ private:
+  /**
+   * @brief The buffer between the producer(s) and the consumer.
+   */
+  channel<T> m_chan;
+};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* FFD3778A_74E9_47B8_A5A5_ABE0069C1D7D */
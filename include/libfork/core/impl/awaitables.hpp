@@ -12,20 +12,24 @@
 #include <atomic>      // for memory_order_acquire, atomic_thread_fence
 #include <bit>         // for bit_cast
 #include <coroutine>   // for coroutine_handle, noop_coroutine, suspend_...
+#include <cstddef>     // for size_t
 #include <cstdint>     // for uint16_t
 #include <iterator>    // for iter_difference_t
+#include <limits>      // for numeric_limits
 #include <memory>      // for operator==, uninitialized_default_construct_n
+#include <new>         // for bad_alloc
 #include <span>        // for span
 #include <type_traits> // for remove_cvref_t
 #include <utility>     // for exchange
 
-#include "libfork/core/co_alloc.hpp"          // for co_allocable, co_new_t, stack_allocated
+#include "libfork/core/co_alloc.hpp"          // for co_allocable, co_new_t, stack_allocated, co_...
 #include "libfork/core/exceptions.hpp"        // for exception_before_join
 #include "libfork/core/ext/context.hpp"       // for full_context
 #include "libfork/core/ext/handles.hpp"       // for submit_handle, submit_node_t, task_handle
 #include "libfork/core/ext/list.hpp"          // for unwrap
 #include "libfork/core/ext/tls.hpp"           // for stack, context
 #include "libfork/core/impl/frame.hpp"        // for frame
+#include "libfork/core/impl/heap_pool.hpp"    // for thread_heap_pool
 #include "libfork/core/impl/stack.hpp"        // for stack
 #include "libfork/core/impl/unique_frame.hpp" // for unique_frame, frame_deleter
 #include "libfork/core/impl/utility.hpp"      // for k_u16_max, checked_cast
@@ -190,6 +194,10 @@ struct alloc_awaitable : std::suspend_never {
    */
   [[nodiscard]] auto await_resume() const -> stack_allocated<T> {
 
+    if (co_new_on_heap<T>(request.count)) {
+      return heap_allocate();
+    }
+
     auto *stack = tls::stack();
 
     LF_ASSERT(stack->top() == self->stacklet()); // Must own the stack.
@@ -214,6 +222,37 @@ struct alloc_awaitable : std::suspend_never {
     return {self, std::span<T>{ptr, request.count}};
   }
 
+  /**
+   * @brief Allocate from the heap pool, the frame is not modified.
+   */
+  [[nodiscard]] auto heap_allocate() const -> stack_allocated<T> {
+
+    if (request.count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      LF_THROW(std::bad_alloc{});
+    }
+
+    auto &pool = thread_heap_pool();
+
+    std::size_t bytes = request.count * sizeof(T);
+
+    T *ptr = static_cast<T *>(pool.allocate(bytes, alignof(T)));
+
+    using int_t = std::iter_difference_t<T *>;
+
+    // clang-format off
+
+    LF_TRY {
+      std::ranges::uninitialized_default_construct_n(ptr, checked_cast<int_t>(request.count));
+    } LF_CATCH_ALL {
+      pool.deallocate(ptr, bytes, alignof(T));
+      LF_RETHROW;
+    }
+
+    // clang-format on
+
+    return {nullptr, std::span<T>{ptr, request.count}};
+  }
+
   /**
    * @brief The requested allocation.
    */
@@ -0,0 +1,182 @@
+#ifndef DD958F0A_1AAE_40F0_975C_196402A8E7AF
+#define DD958F0A_1AAE_40F0_975C_196402A8E7AF
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <array>     // for array
+#include <bit>       // for bit_cast, countr_zero, has_single_bit
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uintptr_t, uint64_t
+#include <exception> // for exception_ptr
+#include <mutex>     // for lock_guard
+#include <new>       // for nothrow
+#include <utility>   // for exchange, move
+#include <vector>    // for vector
+
+#include "libfork/core/defer.hpp"          // for LF_DEFER
+#include "libfork/core/impl/spin_lock.hpp" // for spin_lock
+#include "libfork/core/impl/utility.hpp"   // for immovable, k_cache_line
+
+/**
+ * @file exception_table.hpp
+ *
+ * @brief Out of line storage for the exceptions captured by frames.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief A concurrent multimap from a frame's address to the exceptions it has captured.
+ *
+ * Exceptions are rare hence, rather than reserving space for an ``std::exception_ptr`` in every frame, a
+ * frame only stores a flag and the exceptions are stored here. Every operation is on the cold path.
+ */
+class exception_table : immovable<exception_table> {
+
+  /**
+   * @brief A stored exception.
+   */
+  struct node {
+    /**
+     * @brief The frame that captured the exception.
+     */
+    void const *key;
+    /**
+     * @brief The captured exception.
+     */
+    std::exception_ptr eptr;
+    /**
+     * @brief The next node in the bucket.
+     */
+    node *next;
+  };
+
+  /**
+   * @brief A list of nodes guarded by a lock.
+   */
+  struct alignas(k_cache_line) bucket {
+    /**
+     * @brief Guards `head`.
+     */
+    spin_lock lock;
+    /**
+     * @brief The first node in the bucket.
+     */
+    node *head = nullptr;
+  };
+
+  /**
+   * @brief The number of buckets, a power of two.
+   */
+  static constexpr std::size_t k_buckets = 64;
+  /**
+   * @brief Fibonacci hashing keeps the top `log2(k_buckets)` bits.
+   */
+  static constexpr int k_shift = 64 - std::countr_zero(k_buckets);
+
+  static_assert(std::has_single_bit(k_buckets));
+
+ public:
+  /**
+   * @brief Construct an empty table.
+   */
+  exception_table() = default;
+
+  /**
+   * @brief Store `eptr` for `key`, if there is not enough memory the exception is dropped.
+   */
+  void insert(void const *key, std::exception_ptr eptr) noexcept {
+
+    node *elem = new (std::nothrow) node{key, std::move(eptr), nullptr};
+
+    if (elem == nullptr) {
+      return;
+    }
+
+    bucket &buck = bucket_for(key);
+
+    std::lock_guard lock{buck.lock};
+
+    elem->next = std::exchange(buck.head, elem);
+  }
+
+  /**
+   * @brief Remove and return every exception stored for `key`.
+   */
+  auto take(void const *key) -> std::vector<std::exception_ptr> {
+
+    node *list = nullptr;
+
+    {
+      bucket &buck = bucket_for(key);
+
+      std::lock_guard lock{buck.lock};
+
+      for (node **link = &buck.head; *link != nullptr;) {
+        if (node *elem = *link; elem->key == key) {
+          *link = elem->next;
+          elem->next = std::exchange(list, elem);
+        } else {
+          link = &elem->next;
+        }
+      }
+    }
+
+    LF_DEFER {
+      while (list != nullptr) {
+        delete std::exchange(list, list->next);
+      }
+    };
+
+    std::vector<std::exception_ptr> out;
+
+    for (node *elem = list; elem != nullptr; elem = elem->next) {
+      out.push_back(std::move(elem->eptr));
+    }
+
+    return out;
+  }
+
+  /**
+   * @brief Free all the nodes.
+   */
+  ~exception_table() noexcept {
+    for (bucket &buck : m_buckets) {
+      while (buck.head != nullptr) {
+        delete std::exchange(buck.head, buck.head->next);
+      }
+    }
+  }
+
+ private:
+  /**
+   * @brief Hash a frame's address to its bucket.
+   */
+  auto bucket_for(void const *key) noexcept -> bucket & {
+    std::uint64_t hash = std::uint64_t{std::bit_cast<std::uintptr_t>(key)} * 0x9E3779B97F4A7C15ULL;
+    return m_buckets[static_cast<std::size_t>(hash >> k_shift)];
+  }
+
+  /**
+   * @brief The buckets.
+   */
+  std::array<bucket, k_buckets> m_buckets;
+};
+
+/**
+ * @brief Get the process-wide exception table.
+ */
+inline auto captured_exceptions() noexcept -> exception_table & {
+  static exception_table table;
+  return table;
+}
+
+} // namespace lf::impl
+
+#endif /* DD958F0A_1AAE_40F0_975C_196402A8E7AF */
@@ -9,20 +9,26 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <array>       // for array
 #include <atomic>      // for atomic_ref, memory_order, atomic_uint16_t
-#include <coroutine>   // for coroutine_handle
+#include <coroutine>   // for coroutine_handle, suspend_always
+#include <cstddef>     // for byte, ptrdiff_t
 #include <cstdint>     // for uint16_t
-#include <exception>   // for exception_ptr, operator==, current_exce...
+#include <cstdio>      // for fprintf, stderr
+#include <exception>   // for exception_ptr, current_exception, rethrow_exception, terminate
 #include <memory>      // for construct_at
+#include <new>         // for bad_alloc
 #include <semaphore>   // for binary_semaphore
 #include <type_traits> // for is_standard_layout_v, is_trivially_dest...
-#include <utility>     // for exchange
+#include <utility>     // for exchange, move
+#include <vector>      // for vector
 #include <version>     // for __cpp_lib_atomic_ref
 
+#include "libfork/core/aggregate_exception.hpp"  // for aggregate_exception
 #include "libfork/core/defer.hpp"                // for LF_DEFER
-#include "libfork/core/impl/manual_lifetime.hpp" // for manual_lifetime
+#include "libfork/core/impl/exception_table.hpp" // for captured_exceptions
 #include "libfork/core/impl/stack.hpp"           // for stack
-#include "libfork/core/impl/utility.hpp"         // for non_null, k_u16_max
+#include "libfork/core/impl/utility.hpp"         // for byte_cast, non_null, k_u16_max
 #include "libfork/core/macro.hpp"                // for LF_COMPILER_EXCEPTIONS, LF_ASSERT, LF_F...
 
 /**
@@ -38,13 +44,6 @@ namespace lf::impl {
  */
 class frame {
 
-#if LF_COMPILER_EXCEPTIONS
-  /**
-   * @brief Maybe an exception pointer.
-   */
-  manual_lifetime<std::exception_ptr> m_eptr;
-#endif
-
 #ifndef LF_COROUTINE_OFFSET
   /**
    * @brief Handle to this coroutine, inferred from `this` if `LF_COROUTINE_OFFSET` is set.
@@ -67,6 +66,8 @@ class frame {
     std::binary_semaphore *m_sem;
   };
 
+  // The counters and the exception flag are packed into the last word of the frame.
+
   /**
    * @brief  Number of children joined (with offset).
    */
@@ -77,7 +78,7 @@ class frame {
   std::uint16_t m_steal = 0;
 
 /**
- * @brief Flag to indicate if an exception has been set.
+ * @brief Flag to indicate if an exception has been set, the exceptions are stored out of line.
  */
 #if LF_COMPILER_EXCEPTIONS
   #ifdef __cpp_lib_atomic_ref
@@ -93,11 +94,7 @@ class frame {
   [[noreturn]] LF_NOINLINE void rethrow() {
 #if LF_COMPILER_EXCEPTIONS
 
-    LF_ASSERT(*m_eptr != nullptr);
-
     LF_DEFER {
-      LF_ASSERT(*m_eptr == nullptr);
-      m_eptr.destroy();
   #ifdef __cpp_lib_atomic_ref
       m_except = false;
   #else
@@ -105,7 +102,20 @@ class frame {
   #endif
     };
 
-    std::rethrow_exception(std::exchange(*m_eptr, nullptr));
+    std::vector<std::exception_ptr> all = captured_exceptions().take(this);
+
+  #ifdef LF_AGGREGATE_EXCEPTIONS
+    if (all.size() > 1) {
+      throw aggregate_exception{std::move(all)};
+    }
+  #endif
+
+    if (all.empty()) {
+      // The flag was set but there was not enough memory to store the exception.
+      throw std::bad_alloc{};
+    }
+
+    std::rethrow_exception(std::move(all.front()));
 #else
     std::terminate();
 #endif
@@ -124,7 +134,10 @@ class frame {
     LF_ASSERT(coro);
   }
 #else
-  frame(std::coroutine_handle<>, stack::stacklet *stacklet) noexcept : m_stacklet(non_null(stacklet)) {}
+  frame([[maybe_unused]] std::coroutine_handle<> coro, stack::stacklet *stacklet) noexcept
+      : m_stacklet(non_null(stacklet)) {
+    LF_ASSERT_NO_ASSUME(coro.address() == byte_cast(this) - LF_COROUTINE_OFFSET);
+  }
 #endif
 
   /**
@@ -217,19 +230,25 @@ class frame {
   /**
    * @brief Capture the exception currently being thrown.
    *
-   * Safe to call concurrently, first exception is saved.
+   * Safe to call concurrently, first exception is saved (out of line). If ``LF_AGGREGATE_EXCEPTIONS`` is
+   * defined the rest are saved too and the next rethrow throws an `aggregate_exception` holding them all.
    */
   void capture_exception() noexcept {
 #if LF_COMPILER_EXCEPTIONS
   #ifdef __cpp_lib_atomic_ref
-    bool prev = std::atomic_ref{m_except}.exchange(true, std::memory_order_acq_rel);
+    [[maybe_unused]] bool prev = std::atomic_ref{m_except}.exchange(true, std::memory_order_acq_rel);
   #else
-    bool prev = m_except.exchange(true, std::memory_order_acq_rel);
+    [[maybe_unused]] bool prev = m_except.exchange(true, std::memory_order_acq_rel);
   #endif
 
-    if (!prev) {
-      m_eptr.construct(std::current_exception());
+  #ifndef LF_AGGREGATE_EXCEPTIONS
+    if (prev) {
+      return;
     }
+  #endif
+
+    // If this fails to allocate the rethrow will report std::bad_alloc.
+    captured_exceptions().insert(this, std::current_exception());
 #endif
   }
 
@@ -287,6 +306,87 @@ class frame {
 
 static_assert(std::is_standard_layout_v<frame>);
 
+static_assert(sizeof(frame) <= 4 * sizeof(void *), "The frame should be no larger than four pointers");
+
+#ifdef LF_COROUTINE_OFFSET
+
+/**
+ * @brief A coroutine whose promise has the size and alignment of a frame.
+ */
+struct offset_probe {
+  /**
+   * @brief The probe's promise.
+   */
+  struct promise_type {
+    /**
+     * @brief Get the probe.
+     */
+    auto get_return_object() noexcept -> offset_probe {
+      return {std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    /**
+     * @brief Suspend before the body.
+     */
+    static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+    /**
+     * @brief Suspend at the end.
+     */
+    static auto final_suspend() noexcept -> std::suspend_always { return {}; }
+    /**
+     * @brief Nothing to return.
+     */
+    static void return_void() noexcept {}
+    /**
+     * @brief Nothing can throw.
+     */
+    static void unhandled_exception() noexcept {}
+    /**
+     * @brief Padding.
+     */
+    alignas(frame) std::array<std::byte, sizeof(frame)> bytes;
+  };
+
+  /**
+   * @brief The probe's handle.
+   */
+  std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * @brief Create an `offset_probe`.
+ */
+inline auto make_offset_probe() -> offset_probe { co_return; }
+
+/**
+ * @brief Terminate if `LF_COROUTINE_OFFSET` does not match this compiler's coroutine ABI.
+ */
+inline auto check_coroutine_offset() noexcept -> bool {
+
+  offset_probe probe = make_offset_probe();
+
+  std::ptrdiff_t offset = byte_cast(&probe.handle.promise()) - byte_cast(probe.handle.address());
+
+  probe.handle.destroy();
+
+  if (offset != LF_COROUTINE_OFFSET) {
+    // NOLINTNEXTLINE
+    std::fprintf(stderr,
+                 "libfork: LF_COROUTINE_OFFSET=%td but this compiler's offset is %td\n",
+                 static_cast<std::ptrdiff_t>(LF_COROUTINE_OFFSET),
+                 offset);
+    std::terminate();
+  }
+
+  return true;
+}
+
+/**
+ * @brief Verify `LF_COROUTINE_OFFSET` once, at startup.
+ */
+inline bool const k_coroutine_offset_checked = check_coroutine_offset();
+
+#endif
+
 } // namespace lf::impl
 
 #endif /* DD6F6C5C_C146_4C02_99B9_7D2D132C0844 */
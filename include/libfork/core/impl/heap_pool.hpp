@@ -0,0 +1,176 @@
+#ifndef C6ED3062_3D79_40FC_9A83_C85E0B00DDC5
+#define C6ED3062_3D79_40FC_9A83_C85E0B00DDC5
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm> // for max
+#include <array>     // for array
+#include <bit>       // for bit_ceil, countr_zero, has_single_bit
+#include <cstddef>   // for size_t
+#include <new>       // for align_val_t, operator new, operator delete
+
+#include "libfork/core/impl/utility.hpp" // for immovable, k_new_align
+#include "libfork/core/macro.hpp"        // for LF_ASSERT
+
+/**
+ * @file heap_pool.hpp
+ *
+ * @brief A per-thread, size-class pooled heap allocator for large ``co_new`` allocations.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief The alignment of every block in a `heap_pool`.
+ *
+ * This is large enough for SIMD types up to 512 bits, larger alignments bypass the pool.
+ */
+inline constexpr std::size_t k_pool_align = std::max<std::size_t>(64, k_new_align);
+
+static_assert(std::has_single_bit(k_pool_align));
+
+/**
+ * @brief A cache of heap blocks binned by power-of-two size classes.
+ *
+ * Blocks are released back to the pool of the thread that frees them. Each class caches a few blocks and
+ * the whole pool caches at most `k_max_cached_bytes`, extra blocks are returned to the system, hence a
+ * thread never holds more than a few MiB of idle blocks.
+ */
+class heap_pool : immovable<heap_pool> {
+
+  /**
+   * @brief The smallest size class is `1 << k_min_log` bytes.
+   */
+  static constexpr std::size_t k_min_log = 12;
+  /**
+   * @brief The number of size classes, larger allocations bypass the pool.
+   */
+  static constexpr std::size_t k_classes = 20;
+  /**
+   * @brief The maximum number of cached blocks per size class.
+   */
+  static constexpr std::size_t k_max_cached = 4;
+  /**
+   * @brief The maximum number of bytes cached by a pool, larger blocks are never cached.
+   */
+  static constexpr std::size_t k_max_cached_bytes = std::size_t{1} << 23;
+
+  /**
+   * @brief A free block, stored in the block itself.
+   */
+  struct node {
+    /**
+     * @brief The next free block.
+     */
+    node *next;
+  };
+
+ public:
+  /**
+   * @brief Construct an empty pool.
+   */
+  heap_pool() = default;
+
+  /**
+   * @brief Get the number of bytes `allocate(size, align)` will actually allocate.
+   */
+  [[nodiscard]] static constexpr auto block_size(std::size_t size) noexcept -> std::size_t {
+    return std::bit_ceil(std::max(size, std::size_t{1} << k_min_log));
+  }
+
+  /**
+   * @brief Allocate at least `size` bytes aligned to `align`.
+   */
+  [[nodiscard]] auto allocate(std::size_t size, std::size_t align) -> void * {
+
+    LF_ASSERT(std::has_single_bit(align));
+
+    std::size_t bytes = block_size(size);
+    std::size_t bin = size_class(bytes);
+
+    if (bin < k_classes && align <= k_pool_align) {
+      if (node *head = m_free[bin]) {
+        m_free[bin] = head->next;
+        m_cached[bin] -= 1;
+        m_cached_bytes -= bytes;
+        return head;
+      }
+      return ::operator new(bytes, std::align_val_t{k_pool_align});
+    }
+
+    return ::operator new(bytes, std::align_val_t{std::max(align, k_pool_align)});
+  }
+
+  /**
+   * @brief Release a block allocated by `allocate(size, align)` on any thread's pool.
+   */
+  void deallocate(void *ptr, std::size_t size, std::size_t align) noexcept {
+
+    std::size_t bytes = block_size(size);
+    std::size_t bin = size_class(bytes);
+
+    if (bin < k_classes && align <= k_pool_align) {
+      if (m_cached[bin] < k_max_cached && bytes <= k_max_cached_bytes - m_cached_bytes) {
+        m_free[bin] = ::new (ptr) node{m_free[bin]};
+        m_cached[bin] += 1;
+        m_cached_bytes += bytes;
+        return;
+      }
+      ::operator delete(ptr, bytes, std::align_val_t{k_pool_align});
+      return;
+    }
+
+    ::operator delete(ptr, bytes, std::align_val_t{std::max(align, k_pool_align)});
+  }
+
+  /**
+   * @brief Return all cached blocks to the system.
+   */
+  ~heap_pool() noexcept {
+    for (std::size_t bin = 0; bin < k_classes; ++bin) {
+      while (node *head = m_free[bin]) {
+        m_free[bin] = head->next;
+        ::operator delete(head, std::size_t{1} << (bin + k_min_log), std::align_val_t{k_pool_align});
+      }
+    }
+  }
+
+ private:
+  /**
+   * @brief Map a block size (a power of two) to its size class.
+   */
+  static constexpr auto size_class(std::size_t bytes) noexcept -> std::size_t {
+    return static_cast<std::size_t>(std::countr_zero(bytes)) - k_min_log;
+  }
+
+  /**
+   * @brief The free list of each size class.
+   */
+  std::array<node *, k_classes> m_free = {};
+  /**
+   * @brief The length of each free list.
+   */
+  std::array<std::size_t, k_classes> m_cached = {};
+  /**
+   * @brief The total size of the cached blocks.
+   */
+  std::size_t m_cached_bytes = 0;
+};
+
+/**
+ * @brief Get this thread's heap pool.
+ */
+inline auto thread_heap_pool() noexcept -> heap_pool & {
+  static thread_local heap_pool pool;
+  return pool;
+}
+
+} // namespace lf::impl
+
+#endif /* C6ED3062_3D79_40FC_9A83_C85E0B00DDC5 */
@@ -35,6 +35,7 @@
 #include "libfork/core/scheduler.hpp"       // for context_switcher
 #include "libfork/core/tag.hpp"             // for tag
 #include "libfork/core/task.hpp"            // for returnable, task
+#include "libfork/core/when_all.hpp"        // for when_packet, when_awaitable, some_lazy
 
 /**
  * @file promise.hpp
@@ -260,6 +261,14 @@ struct promise_base : frame {
   auto await_transform(just_wrapped<T> &&awaitable) noexcept -> just_wrapped<T> && {
     return std::move(awaitable);
   }
+
+  /**
+   * @brief Transform a ``when_all``/``when_any`` packet into an awaitable that calls its launcher.
+   */
+  template <typename Fn, returnable R, some_lazy... L>
+  auto await_transform(when_packet<Fn, R, L...> &&packet) -> when_awaitable<R> {
+    return {this, packet};
+  }
 };
 
 /**
@@ -0,0 +1,88 @@
+#ifndef CACACACE_A6A2_4883_AF12_F89557F76C51
+#define CACACACE_A6A2_4883_AF12_F89557F76C51
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>  // for atomic_flag, memory_order_acquire, memory_order_relaxed
+#include <cstddef> // for size_t
+#include <thread>  // for yield
+
+#include "libfork/core/impl/utility.hpp" // for immovable
+#include "libfork/core/macro.hpp"        // for LF_FORCEINLINE
+
+/**
+ * @file spin_lock.hpp
+ *
+ * @brief A minimal spin lock for guarding very short critical sections.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief Hint to the processor that the calling thread is in a spin-wait loop.
+ */
+LF_FORCEINLINE inline void spin_pause() noexcept {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+  __builtin_ia32_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+  __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+/**
+ * @brief A test-and-test-and-set spin lock satisfying the `Lockable` requirements.
+ *
+ * This is used to guard the handful of pointer operations in the synchronization primitives
+ * that suspend coroutines, it should never be held while running user code.
+ */
+class spin_lock : immovable<spin_lock> {
+
+  /**
+   * @brief The number of paused spins before the waiting thread yields its time slice.
+   */
+  static constexpr std::size_t k_spins_before_yield = 64;
+
+ public:
+  /**
+   * @brief Acquire the lock, spinning until it is available.
+   *
+   * Waiters pause between polls and, if the lock is held for a long time (e.g. the holder was
+   * preempted), fall back to yielding the thread.
+   */
+  void lock() noexcept {
+    for (std::size_t spins = 0; m_flag.test_and_set(std::memory_order_acquire);) {
+      while (m_flag.test(std::memory_order_relaxed)) {
+        if (++spins < k_spins_before_yield) {
+          spin_pause();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Attempt to acquire the lock without spinning, returns `true` on success.
+   */
+  [[nodiscard]] auto try_lock() noexcept -> bool {
+    return !m_flag.test(std::memory_order_relaxed) && !m_flag.test_and_set(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Release the lock.
+   */
+  void unlock() noexcept { m_flag.clear(std::memory_order_release); }
+
+ private:
+  std::atomic_flag m_flag = ATOMIC_FLAG_INIT;
+};
+
+} // namespace lf::impl
+
+#endif /* CACACACE_A6A2_4883_AF12_F89557F76C51 */
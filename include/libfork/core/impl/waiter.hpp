@@ -0,0 +1,136 @@
+#ifndef CD57AB25_3B2F_496B_BB0D_C554DF81896E
+#define CD57AB25_3B2F_496B_BB0D_C554DF81896E
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts> // for derived_from
+
+#include "libfork/core/ext/context.hpp"  // for worker_context
+#include "libfork/core/ext/handles.hpp"  // for submit_handle
+#include "libfork/core/ext/tls.hpp"      // for context
+#include "libfork/core/impl/utility.hpp" // for non_null
+#include "libfork/core/macro.hpp"        // for LF_ASSERT
+
+/**
+ * @file waiter.hpp
+ *
+ * @brief Intrusive bookkeeping for coroutines suspended on a synchronization primitive.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief A base class for ``lf::core::context_switcher`` awaitables that park their coroutine.
+ *
+ * The derived awaitable lives in the suspended coroutine's frame hence, it is valid until the
+ * coroutine is woken.
+ */
+struct waiter {
+  /**
+   * @brief Record the suspended coroutine and the worker it is suspending on.
+   */
+  void prime(submit_handle handle) noexcept {
+    m_handle = non_null(handle);
+    m_context = tls::context();
+  }
+
+  /**
+   * @brief Re-submit the coroutine to the worker it suspended on.
+   *
+   * After this call `*this` may have been destroyed.
+   */
+  void wake() noexcept {
+    LF_ASSERT(m_handle && m_context);
+    submit_handle handle = m_handle;
+    worker_context *context = m_context;
+    context->schedule(handle);
+  }
+
+  /**
+   * @brief The next waiter in the queue.
+   */
+  waiter *m_next = nullptr;
+  /**
+   * @brief The suspended coroutine.
+   */
+  submit_handle m_handle = nullptr;
+  /**
+   * @brief The worker to resume the coroutine on.
+   */
+  worker_context *m_context = nullptr;
+};
+
+/**
+ * @brief A (non-thread-safe) intrusive FIFO queue of waiters.
+ */
+template <std::derived_from<waiter> W>
+class waiter_queue {
+ public:
+  /**
+   * @brief Test if the queue is empty.
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_head == nullptr; }
+
+  /**
+   * @brief Get the waiter at the front of the queue without removing it, `nullptr` if the queue is empty.
+   */
+  [[nodiscard]] auto front() const noexcept -> W * { return static_cast<W *>(m_head); }
+
+  /**
+   * @brief Append a waiter to the back of the queue.
+   */
+  void push(W *elem) noexcept {
+
+    waiter *node = non_null(elem);
+
+    LF_ASSERT(node->m_next == nullptr);
+
+    if (m_tail == nullptr) {
+      m_head = node;
+    } else {
+      m_tail->m_next = node;
+    }
+    m_tail = node;
+  }
+
+  /**
+   * @brief Remove the waiter at the front of the queue, returns `nullptr` if the queue is empty.
+   */
+  [[nodiscard]] auto pop() noexcept -> W * {
+
+    waiter *node = m_head;
+
+    if (node != nullptr) {
+      m_head = node->m_next;
+      node->m_next = nullptr;
+      if (m_head == nullptr) {
+        m_tail = nullptr;
+      }
+    }
+
+    return static_cast<W *>(node);
+  }
+
+  /**
+   * @brief Remove every waiter, returning the old queue.
+   */
+  [[nodiscard]] auto take() noexcept -> waiter_queue {
+    waiter_queue out = *this;
+    *this = {};
+    return out;
+  }
+
+ private:
+  waiter *m_head = nullptr;
+  waiter *m_tail = nullptr;
+};
+
+} // namespace lf::impl
+
+#endif /* CD57AB25_3B2F_496B_BB0D_C554DF81896E */
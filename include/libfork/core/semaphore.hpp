@@ -0,0 +1,195 @@
+#ifndef BC232146_C2D0_4432_8281_FED85B13D53C
+#define BC232146_C2D0_4432_8281_FED85B13D53C
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>  // for atomic, memory_order_acquire, memory_order_relaxed
+#include <cstddef> // for size_t
+#include <mutex>   // for lock_guard
+
+#include "libfork/core/ext/handles.hpp"    // for submit_handle
+#include "libfork/core/impl/spin_lock.hpp" // for spin_lock
+#include "libfork/core/impl/utility.hpp"   // for immovable
+#include "libfork/core/impl/waiter.hpp"    // for waiter, waiter_queue
+#include "libfork/core/macro.hpp"          // for LF_ASSERT
+#include "libfork/core/scheduler.hpp"      // for context_switcher
+
+/**
+ * @file semaphore.hpp
+ *
+ * @brief A counting semaphore and a mutex that suspend coroutines instead of threads.
+ */
+
+namespace lf {
+
+inline namespace core {
+
+/**
+ * @brief A counting semaphore for use inside libfork tasks.
+ *
+ * Awaiting `acquire()` is an ``lf::core::context_switcher``, if no permits are available the coroutine
+ * (not the thread) is parked on an intrusive, FIFO waiter list. A `release()` hands its permit directly to
+ * the oldest waiter and re-submits it to the worker it suspended on.
+ *
+ * \rst
+ *
+ * .. note::
+ *
+ *    No coroutines may be suspended on a semaphore when it is destroyed.
+ *
+ * \endrst
+ */
+class async_semaphore : impl::immovable<async_semaphore> {
+
+  /**
+   * @brief The awaitable returned by `acquire()`.
+   */
+  class [[nodiscard("This should be immediately co_awaited")]] acquire_awaitable : public impl::waiter {
+   public:
+    /**
+     * @brief Attempt to acquire a permit without suspending.
+     */
+    auto await_ready() noexcept -> bool { return m_sem->try_acquire(); }
+
+    /**
+     * @brief Park this coroutine until a permit is released.
+     */
+    void await_suspend(submit_handle handle) noexcept {
+
+      prime(handle);
+
+      bool ready = [&] {
+        std::lock_guard lock{m_sem->m_lock};
+        if (m_sem->try_acquire()) {
+          return true;
+        }
+        m_sem->m_waiters.push(this);
+        return false;
+      }();
+
+      // If enqueued we may already have been woken, cannot touch `this`.
+
+      if (ready) {
+        wake();
+      }
+    }
+
+    /**
+     * @brief A no-op, the permit is owned upon resumption.
+     */
+    static auto await_resume() noexcept -> void {}
+
+   private:
+    friend class async_semaphore;
+
+    explicit acquire_awaitable(async_semaphore *sem) noexcept : m_sem{sem} {}
+
+    async_semaphore *m_sem;
+  };
+
+  static_assert(context_switcher<acquire_awaitable>);
+
+ public:
+  /**
+   * @brief Construct a semaphore with `count` permits available.
+   */
+  explicit async_semaphore(std::size_t count) noexcept : m_count{count} {}
+
+  /**
+   * @brief Destroy the semaphore, no coroutines may be suspended on it.
+   */
+  ~async_semaphore() noexcept { LF_ASSERT(m_waiters.empty()); }
+
+  /**
+   * @brief Attempt to take a permit without suspending, returns `true` on success.
+   */
+  [[nodiscard]] auto try_acquire() noexcept -> bool {
+
+    std::size_t count = m_count.load(std::memory_order_relaxed);
+
+    while (count > 0) {
+      if (m_count.compare_exchange_weak(
+              count, count - 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Take a permit, awaiting the result suspends the coroutine until one is available.
+   */
+  [[nodiscard]] auto acquire() noexcept -> acquire_awaitable { return acquire_awaitable{this}; }
+
+  /**
+   * @brief Return `n` permits, waking up to `n` suspended coroutines.
+   */
+  void release(std::size_t n = 1) noexcept {
+
+    impl::waiter_queue<acquire_awaitable> woken;
+
+    {
+      std::lock_guard lock{m_lock};
+
+      for (; n > 0; --n) {
+        if (acquire_awaitable *next = m_waiters.pop()) {
+          woken.push(next);
+        } else {
+          break;
+        }
+      }
+
+      // Waiters are only enqueued when there are no permits hence, any left-overs can be published.
+      m_count.fetch_add(n, std::memory_order_release);
+    }
+
+    while (acquire_awaitable *next = woken.pop()) {
+      next->wake();
+    }
+  }
+
+ private:
+  impl::spin_lock m_lock;
+  std::atomic<std::size_t> m_count;
+  impl::waiter_queue<acquire_awaitable> m_waiters;
+};
+
+/**
+ * @brief A mutex for use inside libfork tasks.
+ *
+ * Awaiting `lock()` is an ``lf::core::context_switcher``, contended lockers park their coroutine
+ * (not the thread) and are re-submitted, in FIFO order, by `unlock()`.
+ */
+class async_mutex : impl::immovable<async_mutex> {
+ public:
+  /**
+   * @brief Attempt to lock the mutex without suspending, returns `true` on success.
+   */
+  [[nodiscard]] auto try_lock() noexcept -> bool { return m_sem.try_acquire(); }
+
+  /**
+   * @brief Lock the mutex, awaiting the result suspends the coroutine until the lock is acquired.
+   */
+  [[nodiscard]] auto lock() noexcept { return m_sem.acquire(); }
+
+  /**
+   * @brief Unlock the mutex, ownership is transferred directly to the oldest waiter (if any).
+   */
+  void unlock() noexcept { m_sem.release(); }
+
+ private:
+  async_semaphore m_sem{1};
+};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* BC232146_C2D0_4432_8281_FED85B13D53C */
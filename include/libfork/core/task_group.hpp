@@ -0,0 +1,605 @@
+#ifndef E41C6D30_5DDA_4F8E_8A06_76E8A772CF36
+#define E41C6D30_5DDA_4F8E_8A06_76E8A772CF36
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <concepts>    // for convertible_to, invocable
+#include <cstddef>     // for size_t
+#include <deque>       // for deque
+#include <functional>  // for invoke
+#include <memory>      // for addressof
+#include <tuple>       // for tuple, apply
+#include <type_traits> // for is_void_v, is_lvalue_reference_v
+#include <utility>     // for forward, move
+#include <vector>      // for vector
+
+#include "libfork/core/control_flow.hpp" // for fork, call, join
+#include "libfork/core/eventually.hpp"   // for eventually
+#include "libfork/core/first_arg.hpp"    // for async_function_object
+#include "libfork/core/impl/utility.hpp" // for immovable, empty_t, non_void
+#include "libfork/core/invocable.hpp"    // for discard_t, async_result_t, callable
+#include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_TRY, LF_CATCH_ALL
+#include "libfork/core/task.hpp"         // for returnable
+
+/**
+ * @file task_group.hpp
+ *
+ * @brief Groups of a dynamic number of children, with per-child results or a result callback.
+ *
+ * Also provides a child-stealing group, that defers its children instead of running them immediately.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief A return address (quasi-pointer) that hands the result of a child to a callback.
+ *
+ * The callback is type-erased such that the type of the return address, and hence the type of the
+ * child's first argument, does not depend on the type of the callback. Otherwise a recursive async
+ * function that declares a callback would instantiate itself indefinitely.
+ */
+template <non_void T>
+class callback_return {
+
+  /**
+   * @brief The type-erased invoker.
+   */
+  using invoke_t = void (*)(void *, T &&);
+
+ public:
+  /**
+   * @brief The proxy returned by dereferencing, assigning to it invokes the callback.
+   */
+  struct proxy {
+    /**
+     * @brief Invoke the callback with `value` converted to a `T`.
+     */
+    template <typename U>
+      requires std::convertible_to<U, T>
+    auto operator=(U &&value) const -> proxy const & {
+      invoke(context, static_cast<T>(std::forward<U>(value)));
+      return *this;
+    }
+
+    /**
+     * @brief The callback to invoke.
+     */
+    void *context;
+    /**
+     * @brief The callback's invoker.
+     */
+    invoke_t invoke;
+  };
+
+  /**
+   * @brief Construct a null return address.
+   */
+  constexpr callback_return() noexcept = default;
+
+  /**
+   * @brief Construct a return address that invokes `callback`.
+   */
+  template <typename Callback>
+    requires std::invocable<Callback &, T>
+  constexpr explicit callback_return(Callback &callback) noexcept
+      : m_context{std::addressof(callback)},
+        m_invoke{[](void *context, T &&value) {
+          std::invoke(*static_cast<Callback *>(context), std::forward<T>(value));
+        }} {}
+
+  /**
+   * @brief Get the proxy that forwards to the callback.
+   */
+  [[nodiscard]] constexpr auto operator*() const noexcept -> proxy {
+    LF_ASSERT(m_context && m_invoke);
+    return {m_context, m_invoke};
+  }
+
+ private:
+  /**
+   * @brief The address of the callback.
+   */
+  void *m_context = nullptr;
+  /**
+   * @brief The callback's invoker.
+   */
+  invoke_t m_invoke = nullptr;
+};
+
+/**
+ * @brief The result storage of a `lf::task_group<T>`, a deque never moves its elements as it grows.
+ */
+template <typename T>
+struct group_slots {
+  /**
+   * @brief One ``lf::eventually`` per child.
+   */
+  using type = std::deque<eventually<T>>;
+};
+
+/**
+ * @brief A `void` group only counts its children.
+ */
+template <>
+struct group_slots<void> {
+  /**
+   * @brief No storage.
+   */
+  using type = empty_t<>;
+};
+
+/**
+ * @brief The result slot of a deferred child returning `R`.
+ */
+template <returnable R>
+struct deferred_slot {
+  /**
+   * @brief An ``lf::eventually`` for non-void results.
+   */
+  using type = eventually<R>;
+};
+
+/**
+ * @brief Void children need no storage.
+ */
+template <>
+struct deferred_slot<void> {
+  /**
+   * @brief No storage.
+   */
+  using type = empty_t<>;
+};
+
+/**
+ * @brief The arguments and result slot of a child that has been pushed to a ``deferred_group``.
+ */
+template <returnable R, typename... Args>
+struct deferred_child {
+  /**
+   * @brief A copy of the arguments.
+   */
+  std::tuple<Args...> args;
+  /**
+   * @brief The result of the child.
+   */
+  [[no_unique_address]] typename deferred_slot<R>::type result;
+};
+
+/**
+ * @brief The async function that runs the children `[lo, hi)` of a ``deferred_group`` by recursive halving.
+ *
+ * The children are reached through an array of pointers owned by the launch, hence the group may push
+ * more children while these are running.
+ */
+struct deferred_fn {
+  /**
+   * @brief Fork the lower half, call the upper half and join, each leaf calls one child.
+   */
+  template <typename Group, typename Child>
+  LF_STATIC_CALL auto
+  operator()(auto self, Group *group, Child *const *children, std::size_t lo, std::size_t hi)
+      LF_STATIC_CONST->task<> {
+
+    LF_ASSERT(lo <= hi);
+
+    if (lo == hi) {
+      co_return;
+    }
+
+    if (hi - lo == 1) {
+      co_await group->launch(*children[lo]);
+      co_await lf::join;
+      co_return;
+    }
+
+    std::size_t mid = lo + (hi - lo) / 2;
+
+    // clang-format off
+
+    co_await lf::fork(self)(group, children, lo, mid);
+
+    LF_TRY {
+      co_await lf::call(self)(group, children, mid, hi);
+    } LF_CATCH_ALL {
+      self.stash_exception();
+    }
+
+    // clang-format on
+
+    co_await lf::join;
+  }
+};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief A group of a dynamic number of child tasks with a result slot per child.
+ *
+ * A task group is declared in a task and then any number of children can be forked (or called) into it,
+ * each child gets a fresh ``lf::eventually<T>`` return slot. Slots are appended as the children are forked
+ * hence, no storage needs to be allocated up front and the address of a slot is stable for the lifetime
+ * of the group.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    lf::task_group<int> group;
+ *
+ *    for (auto &&child : node.children) {
+ *      co_await group.fork(visit)(child);
+ *    }
+ *
+ *    co_await lf::join;
+ *
+ *    for (auto &slot : group) { use(*slot); }
+ *
+ * .. note::
+ *
+ *    A group's children are children of the task that forks them and are joined by that task's next
+ *    ``co_await lf::join``. Joining a group independently of the frame's join, i.e. of the task's other
+ *    children, is not supported. As a workaround the group can be declared in the outer task and forked
+ *    into from a nested task that is invoked with ``lf::call``, this costs an extra frame and the nested
+ *    task's join still waits for all of its children.
+ *
+ * \endrst
+ *
+ * The results may only be accessed after the children have been joined. If `T` is `void` then the group
+ * only counts its children.
+ */
+template <returnable T = void>
+class task_group : impl::immovable<task_group<T>> {
+ public:
+  /**
+   * @brief Construct an empty group.
+   */
+  task_group() = default;
+
+  /**
+   * @brief Bind a new return slot to `fun`, the result is awaitable like ``lf::fork(&slot, fun)``.
+   */
+  template <async_function_object F>
+  [[nodiscard]] auto fork(F &&fun) {
+    return lf::fork(next(), std::forward<F>(fun));
+  }
+
+  /**
+   * @brief Bind a new return slot to `fun`, the result is awaitable like ``lf::call(&slot, fun)``.
+   */
+  template <async_function_object F>
+  [[nodiscard]] auto call(F &&fun) {
+    return lf::call(next(), std::forward<F>(fun));
+  }
+
+  /**
+   * @brief The number of children forked or called into this group.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    if constexpr (std::is_void_v<T>) {
+      return m_count;
+    } else {
+      return m_slots.size();
+    }
+  }
+
+  /**
+   * @brief Access the result of the `i`th child, only valid after a join.
+   */
+  [[nodiscard]] auto operator[](std::size_t i) -> decltype(auto)
+    requires (!std::is_void_v<T>)
+  {
+    LF_ASSERT(i < m_slots.size());
+    return *m_slots[i];
+  }
+
+  /**
+   * @brief An iterator to the first ``lf::eventually`` result slot, only valid after a join.
+   */
+  [[nodiscard]] auto begin() noexcept
+    requires (!std::is_void_v<T>)
+  {
+    return m_slots.begin();
+  }
+
+  /**
+   * @brief An iterator past the last result slot.
+   */
+  [[nodiscard]] auto end() noexcept
+    requires (!std::is_void_v<T>)
+  {
+    return m_slots.end();
+  }
+
+  /**
+   * @brief Destroy all the results and reset the group to empty, must be outside a fork-join scope.
+   */
+  void clear() noexcept {
+    if constexpr (std::is_void_v<T>) {
+      m_count = 0;
+    } else {
+      m_slots.clear();
+    }
+  }
+
+ private:
+  /**
+   * @brief Get the return address for the next child.
+   */
+  auto next() {
+    if constexpr (std::is_void_v<T>) {
+      ++m_count;
+      return impl::discard_t{};
+    } else {
+      return &m_slots.emplace_back();
+    }
+  }
+
+  /**
+   * @brief The number of children in a `void` group.
+   */
+  std::size_t m_count = 0;
+  /**
+   * @brief The result slots of a non-`void` group.
+   */
+  [[no_unique_address]] typename impl::group_slots<T>::type m_slots;
+};
+
+/**
+ * @brief A group of a dynamic number of child tasks whose results are passed to a callback.
+ *
+ * This is like ``lf::task_group`` but no storage is needed per child, as soon as a child returns its result
+ * is passed to ``callback(std::move(result))``. The callback is invoked by the thread that completes the
+ * child hence, __it may be invoked concurrently__ and it must synchronize any shared state itself.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::atomic<long> total = 0;
+ *
+ *    auto on_result = [&](long x) { total += x; };
+ *
+ *    lf::callback_group<long> group{on_result};
+ *
+ *    for (auto &&child : node.children) {
+ *      co_await group.fork(visit)(child);
+ *    }
+ *
+ *    co_await lf::join;
+ *
+ * \endrst
+ *
+ * A callback group has the same joining rules as a ``lf::task_group``. The group refers to the callback,
+ * which must not be destroyed before the children are joined.
+ */
+template <impl::non_void T>
+class callback_group : impl::immovable<callback_group<T>> {
+ public:
+  /**
+   * @brief Construct a group that passes results to `callback`.
+   */
+  template <typename Callback>
+    requires std::invocable<Callback &, T>
+  explicit callback_group(Callback &callback) noexcept : m_return{callback} {}
+
+  /**
+   * @brief A group must not outlive its callback.
+   */
+  template <typename Callback>
+    requires (!std::is_lvalue_reference_v<Callback>)
+  explicit callback_group(Callback &&callback) = delete;
+
+  /**
+   * @brief Bind `fun` to this group's callback, the result is awaitable like ``lf::fork(ret, fun)``.
+   */
+  template <async_function_object F>
+  [[nodiscard]] auto fork(F &&fun) {
+    ++m_count;
+    return lf::fork(m_return, std::forward<F>(fun));
+  }
+
+  /**
+   * @brief Bind `fun` to this group's callback, the result is awaitable like ``lf::call(ret, fun)``.
+   */
+  template <async_function_object F>
+  [[nodiscard]] auto call(F &&fun) {
+    ++m_count;
+    return lf::call(m_return, std::forward<F>(fun));
+  }
+
+  /**
+   * @brief The number of children forked or called into this group.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_count; }
+
+ private:
+  /**
+   * @brief The return address shared by all the children.
+   */
+  impl::callback_return<T> m_return;
+  /**
+   * @brief The number of children.
+   */
+  std::size_t m_count = 0;
+};
+
+/**
+ * @brief A child-stealing group, children are pushed to the group and run later in parallel.
+ *
+ * Libfork uses continuation stealing: ``lf::fork`` runs the child immediately and exposes the parent's
+ * continuation to thieves. This is the best policy for recursive, divide and conquer, code. However, if a
+ * single task forks a wide, flat loop of children then each steal migrates the loop to a new thread. A
+ * deferred group implements the child-stealing policy at a call site: ``push(args...)`` records a child
+ * and returns immediately, the loop runs to completion without switching stacks and then ``fork()``
+ * launches all the pushed children as a balanced tree that thieves steal halves of.
+ *
+ * \rst
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    lf::deferred_group<decltype(validate), record const *> group{validate};
+ *
+ *    for (auto const &rec : batch) {
+ *      group.push(&rec);
+ *    }
+ *
+ *    co_await group.fork();
+ *    co_await lf::join;
+ *
+ *    for (std::size_t i = 0; i < group.size(); ++i) { use(group[i]); }
+ *
+ * .. note::
+ *
+ *    Pushing is cheap (a copy of the arguments) but the children are not started until the group is
+ *    launched and the arguments are stored until the group is cleared, prefer ``lf::fork`` for recursive
+ *    code and the deferred group for flat loops of many small children.
+ *
+ * \endrst
+ *
+ * Like ``std::thread`` the arguments are copied, use pointers or ``std::ref`` to pass a reference. The
+ * children are called as `fun(self, args...)` with the stored arguments as lvalues. The results may only
+ * be accessed after the children have been joined. The group can be launched multiple times, each launch
+ * runs the children pushed since the previous launch, children may be pushed while earlier launches are
+ * running.
+ */
+template <async_function_object F, typename... Args>
+  requires callable<F, Args &...>
+class deferred_group : impl::immovable<deferred_group<F, Args...>> {
+
+  /**
+   * @brief The result type of the children.
+   */
+  using result_type = async_result_t<F, Args &...>;
+
+  /**
+   * @brief The storage for a child.
+   */
+  using child_type = impl::deferred_child<result_type, Args...>;
+
+  friend struct impl::deferred_fn;
+
+ public:
+  /**
+   * @brief Construct an empty group whose children call `fun`.
+   */
+  explicit deferred_group(F fun) noexcept(std::is_nothrow_move_constructible_v<F>) : m_fun{std::move(fun)} {}
+
+  /**
+   * @brief Record a child called with a copy of `args`, the child is not started.
+   */
+  void push(Args... args) { m_children.emplace_back(std::tuple<Args...>{std::move(args)...}); }
+
+  /**
+   * @brief Launch the pending children, the result is awaitable like ``lf::fork(fun)(...)``.
+   */
+  [[nodiscard]] auto fork() {
+    std::vector<child_type *> const &pending = take_pending();
+    return lf::fork(impl::deferred_fn{})(this, pending.data(), std::size_t{0}, pending.size());
+  }
+
+  /**
+   * @brief Launch the pending children, the result is awaitable like ``lf::call(fun)(...)``.
+   */
+  [[nodiscard]] auto call() {
+    std::vector<child_type *> const &pending = take_pending();
+    return lf::call(impl::deferred_fn{})(this, pending.data(), std::size_t{0}, pending.size());
+  }
+
+  /**
+   * @brief The number of children pushed to this group.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_children.size(); }
+
+  /**
+   * @brief Access the result of the `i`th child, only valid after a join.
+   */
+  [[nodiscard]] auto operator[](std::size_t i) -> decltype(auto)
+    requires (!std::is_void_v<result_type>)
+  {
+    LF_ASSERT(i < m_launched);
+    return *m_children[i].result;
+  }
+
+  /**
+   * @brief Destroy all the children and reset the group to empty, must be outside a fork-join scope.
+   */
+  void clear() noexcept {
+    m_children.clear();
+    m_launches.clear();
+    m_launched = 0;
+  }
+
+ private:
+  /**
+   * @brief Mark the pending children as launched and get stable pointers to them.
+   *
+   * Running children only read these pointers, never the deque's internal map which `push` may
+   * reallocate.
+   */
+  auto take_pending() -> std::vector<child_type *> const & {
+
+    std::vector<child_type *> &pending = m_launches.emplace_back();
+
+    pending.reserve(m_children.size() - m_launched);
+
+    for (; m_launched < m_children.size(); ++m_launched) {
+      pending.push_back(&m_children[m_launched]);
+    }
+
+    return pending;
+  }
+
+  /**
+   * @brief Call a child.
+   */
+  auto launch(child_type &child) {
+    return std::apply(
+        [&](Args &...args) {
+          if constexpr (std::is_void_v<result_type>) {
+            return lf::call(m_fun)(args...);
+          } else {
+            return lf::call(&child.result, m_fun)(args...);
+          }
+        },
+        child.args);
+  }
+
+  /**
+   * @brief The async function the children call.
+   */
+  [[no_unique_address]] F m_fun;
+  /**
+   * @brief The children, a deque such that pushing does not move the children.
+   */
+  std::deque<child_type> m_children;
+  /**
+   * @brief The pointers to the children of each launch, the buffers are stable while the children run.
+   */
+  std::deque<std::vector<child_type *>> m_launches;
+  /**
+   * @brief The number of children that have been launched.
+   */
+  std::size_t m_launched = 0;
+};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* E41C6D30_5DDA_4F8E_8A06_76E8A772CF36 */
@@ -0,0 +1,684 @@
+#ifndef F71F68C5_FDB9_4658_B122_0FCAAAE4D031
+#define F71F68C5_FDB9_4658_B122_0FCAAAE4D031
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <atomic>      // for atomic, memory_order_acq_rel, memory_order_relaxed
+#include <concepts>    // for constructible_from
+#include <cstddef>     // for size_t
+#include <exception>   // for rethrow_exception
+#include <expected>    // for expected, unexpected
+#include <optional>    // for optional
+#include <tuple>       // for tuple, get, apply
+#include <type_traits> // for decay_t, conditional_t, is_void_v, integral_constant, is_reference_v
+#include <utility>     // for forward, move, index_sequence, index_sequence_for, in_place_index
+#include <variant>     // for variant, monostate
+
+#include "libfork/core/control_flow.hpp"   // for join
+#include "libfork/core/eventually.hpp"     // for eventually
+#include "libfork/core/first_arg.hpp"      // for async_function_object
+#include "libfork/core/impl/awaitables.hpp" // for call_awaitable
+#include "libfork/core/impl/combinate.hpp" // for combinate
+#include "libfork/core/impl/frame.hpp"     // for frame
+#include "libfork/core/impl/utility.hpp"   // for unqualified
+#include "libfork/core/invocable.hpp"      // for callable, async_result_t, discard_t
+#include "libfork/core/just.hpp"           // for just_awaitable_base
+#include "libfork/core/macro.hpp"          // for LF_STATIC_CALL, LF_STATIC_CONST, LF_DEPRECATE_CALL
+#include "libfork/core/tag.hpp"            // for tag, modifier
+#include "libfork/core/task.hpp"           // for task, returnable
+
+/**
+ * @file when_all.hpp
+ *
+ * @brief Combinators that fork a set of (heterogeneous) async calls and join them.
+ */
+
+namespace lf {
+
+namespace impl {
+
+// ---------------- Lazy calls ---------------- //
+
+/**
+ * @brief An async function and its arguments, bound but not yet invoked.
+ *
+ * The arguments are stored by reference, a lazy call must be consumed in the full-expression that created it.
+ */
+template <async_function_object F, typename... Args>
+  requires callable<F, Args...>
+struct [[nodiscard("Pass this to lf::when_all or lf::when_any!")]] lazy_call {
+  /**
+   * @brief The result type of the call.
+   */
+  using result_type = async_result_t<F, Args...>;
+  /**
+   * @brief The async function.
+   */
+  [[no_unique_address]] F fun;
+  /**
+   * @brief References to the arguments.
+   */
+  std::tuple<Args &&...> args;
+};
+
+namespace detail {
+
+template <class>
+struct some_lazy_impl : std::false_type {};
+
+template <class F, class... Args>
+struct some_lazy_impl<lazy_call<F, Args...>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Test if a type is a ``lazy_call`` specialization.
+ */
+template <class T>
+concept some_lazy = detail::some_lazy_impl<std::remove_cvref_t<T>>::value;
+
+/**
+ * @brief A wrapper that supplies an async function with a call operator that binds its arguments.
+ */
+template <unqualified F>
+struct [[nodiscard("This should be immediately invoked!")]] call_lazy {
+  /**
+   * @brief Bind `args` to the async function.
+   */
+  template <typename... Args>
+    requires callable<F, Args...>
+  auto operator()(Args &&...args) && -> lazy_call<F, Args...> {
+    return {std::move(fun), {std::forward<Args>(args)...}};
+  }
+  /**
+   * @brief The async function.
+   */
+  [[no_unique_address]] F fun;
+};
+
+/**
+ * @brief An invocable (and subscriptable) wrapper that makes an async function object lazily callable.
+ */
+struct bind_lazy {
+  /**
+   * @brief Make an async function object lazily callable.
+   *
+   * We use `std::decay_t` here as `F` may be a reference to function pointer.
+   */
+  template <typename F>
+    requires std::constructible_from<std::decay_t<F>, F>
+  LF_DEPRECATE_CALL LF_STATIC_CALL auto operator()(F &&fun) LF_STATIC_CONST->call_lazy<std::decay_t<F>> {
+    return {std::forward<F>(fun)};
+  }
+
+#if defined(__cpp_multidimensional_subscript) && __cpp_multidimensional_subscript >= 202211L
+  /**
+   * @brief Make an async function object lazily callable.
+   *
+   * We use `std::decay_t` here as `F` may be a reference to function pointer.
+   */
+  template <typename F>
+    requires std::constructible_from<std::decay_t<F>, F>
+  LF_STATIC_CALL auto operator[](F &&fun) LF_STATIC_CONST->call_lazy<std::decay_t<F>> {
+    return {std::forward<F>(fun)};
+  }
+#endif
+};
+
+// ---------------- Helpers ---------------- //
+
+/**
+ * @brief The value a combinator reports for a child returning `R`, `void` is mapped to `std::monostate`.
+ */
+template <returnable R>
+using when_value_t = std::conditional_t<std::is_void_v<R>, std::monostate, R>;
+
+/**
+ * @brief Storage for the result of a child returning `R`.
+ */
+template <returnable R>
+struct when_slot {
+  /**
+   * @brief An ``lf::eventually`` for non-void results.
+   */
+  using type = eventually<R>;
+};
+
+/**
+ * @brief Void children need no storage.
+ */
+template <>
+struct when_slot<void> {
+  /**
+   * @brief A placeholder.
+   */
+  using type = std::monostate;
+};
+
+/**
+ * @brief Storage for the result of a child returning `R`.
+ */
+template <returnable R>
+using when_slot_t = typename when_slot<R>::type;
+
+/**
+ * @brief Bind a lazy call's return address to `slot` and invoke it with tag `Tag`.
+ */
+template <tag Tag, typename Slot, some_lazy L>
+auto launch(Slot &slot, L &call) {
+
+  using R = typename L::result_type;
+
+  return std::apply(
+      [&]<typename... Args>(Args &&...args) {
+        if constexpr (std::is_void_v<R>) {
+          auto bound = combinate<Tag, modifier::none>(discard_t{}, std::move(call.fun));
+          return std::move(bound)(std::forward<Args>(args)...);
+        } else {
+          return combinate<Tag, modifier::none>(&slot, std::move(call.fun))(std::forward<Args>(args)...);
+        }
+      },
+      std::move(call.args));
+}
+
+/**
+ * @brief Fork all but the last call, the last call is made with a call as the parent's continuation
+ * would only be stolen to perform a join.
+ */
+template <std::size_t I, std::size_t N>
+inline constexpr tag launch_tag = I + 1 == N ? tag::call : tag::fork;
+
+/**
+ * @brief Extract the value from a joined result slot.
+ */
+template <returnable R>
+auto take(when_slot_t<R> &slot) -> when_value_t<R> {
+  if constexpr (std::is_void_v<R>) {
+    return {};
+  } else {
+    return *std::move(slot);
+  }
+}
+
+// ---------------- When all ---------------- //
+
+/**
+ * @brief The async function that forks each call in a ``when_all`` and joins them.
+ */
+struct when_all_fn {
+  /**
+   * @brief Launch the calls and return a tuple of their results.
+   */
+  template <some_lazy... L, std::size_t... I>
+  LF_STATIC_CALL auto operator()(auto /* unused */, std::tuple<L...> *calls, std::index_sequence<I...>)
+      LF_STATIC_CONST->task<std::tuple<when_value_t<typename L::result_type>...>> {
+
+    using value_type = std::tuple<when_value_t<typename L::result_type>...>;
+
+    constexpr std::size_t n = sizeof...(L);
+
+    std::tuple<when_slot_t<typename L::result_type>...> slots;
+
+    (co_await launch<launch_tag<I, n>>(std::get<I>(slots), std::get<I>(*calls)), ...);
+
+    co_await lf::join;
+
+    co_return value_type{take<typename L::result_type>(std::get<I>(slots))...};
+  }
+};
+
+// ---------------- When any ---------------- //
+
+/**
+ * @brief The state shared by the children of a ``when_any``.
+ */
+template <typename V>
+struct any_state {
+  /**
+   * @brief Set by the first child to complete.
+   */
+  std::atomic<bool> done = false;
+  /**
+   * @brief The result of the first child to complete.
+   */
+  std::optional<V> value;
+};
+
+/**
+ * @brief The async function wrapping each child of a ``when_any``.
+ */
+struct any_child_fn {
+  /**
+   * @brief Run the `I`th call unless a sibling has already completed, then try to claim the result.
+   */
+  template <std::size_t I, typename V, some_lazy L>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, std::integral_constant<std::size_t, I>, any_state<V> *state, L *call)
+      LF_STATIC_CONST->task<> {
+
+    using R = typename L::result_type;
+
+    if (state->done.load(std::memory_order_relaxed)) {
+      co_return; // Cancelled, a sibling has already completed.
+    }
+
+    when_slot_t<R> slot;
+
+    co_await launch<tag::call>(slot, *call);
+    co_await lf::join;
+
+    if (!state->done.exchange(true, std::memory_order_acq_rel)) {
+      state->value.emplace(std::in_place_index<I>, take<R>(slot));
+    }
+  }
+};
+
+/**
+ * @brief The async function that forks each call in a ``when_any`` and joins them.
+ */
+struct when_any_fn {
+  /**
+   * @brief Launch the calls and return the result of the first to complete.
+   */
+  template <some_lazy... L, std::size_t... I>
+  LF_STATIC_CALL auto operator()(auto /* unused */, std::tuple<L...> *calls, std::index_sequence<I...>)
+      LF_STATIC_CONST->task<std::variant<when_value_t<typename L::result_type>...>> {
+
+    using value_type = std::variant<when_value_t<typename L::result_type>...>;
+
+    constexpr std::size_t n = sizeof...(L);
+
+    any_state<value_type> state;
+
+    // clang-format off
+
+    (co_await combinate<launch_tag<I, n>, modifier::none>(discard_t{}, any_child_fn{})(
+        std::integral_constant<std::size_t, I>{}, &state, &std::get<I>(*calls)
+    ), ...);
+
+    // clang-format on
+
+    co_await lf::join;
+
+    LF_ASSERT(state.value.has_value());
+
+    co_return *std::move(state.value);
+  }
+};
+
+// ---------------- When all expected ---------------- //
+
+namespace detail {
+
+template <class>
+struct expected_impl : std::false_type {};
+
+template <class T, class E>
+struct expected_impl<std::expected<T, E>> : std::true_type {
+  using value_type = T;
+  using error_type = E;
+};
+
+} // namespace detail
+
+/**
+ * @brief Test if a type is a ``std::expected`` specialization.
+ */
+template <class T>
+concept some_expected = detail::expected_impl<T>::value;
+
+/**
+ * @brief A lazy call returning a ``std::expected`` with error type `E`.
+ */
+template <class L, class E>
+concept lazy_expected = some_lazy<L> && some_expected<typename L::result_type> &&
+                        std::same_as<typename detail::expected_impl<typename L::result_type>::error_type, E>;
+
+/**
+ * @brief The value a ``when_all_expected`` reports for a child returning `R`.
+ */
+template <some_expected R>
+using expected_value_t = when_value_t<typename detail::expected_impl<R>::value_type>;
+
+/**
+ * @brief The state shared by the children of a ``when_all_expected``.
+ */
+template <typename E>
+struct expected_state {
+  /**
+   * @brief Set by the first child to fail.
+   */
+  std::atomic<bool> failed = false;
+  /**
+   * @brief The error of the first child to fail.
+   */
+  std::optional<E> error;
+};
+
+/**
+ * @brief The async function wrapping each child of a ``when_all_expected``.
+ */
+struct expected_child_fn {
+  /**
+   * @brief Run a call unless a sibling has already failed, then report an error to the siblings.
+   */
+  template <typename E, some_lazy L>
+  LF_STATIC_CALL auto
+  operator()(auto /* unused */, expected_state<E> *state, eventually<typename L::result_type> *slot, L *call)
+      LF_STATIC_CONST->task<> {
+
+    if (state->failed.load(std::memory_order_relaxed)) {
+      co_return; // Short-circuit, a sibling has already failed.
+    }
+
+    co_await launch<tag::call>(*slot, *call);
+    co_await lf::join;
+
+    if (!**slot && !state->failed.exchange(true, std::memory_order_acq_rel)) {
+      state->error.emplace(std::move(**slot).error());
+    }
+  }
+};
+
+/**
+ * @brief Extract the value from a successful child's result slot.
+ */
+template <some_expected R>
+auto take_expected(eventually<R> &slot) -> expected_value_t<R> {
+  if constexpr (std::is_void_v<typename detail::expected_impl<R>::value_type>) {
+    return {};
+  } else {
+    return *std::move(*std::move(slot));
+  }
+}
+
+/**
+ * @brief The async function that forks each call in a ``when_all_expected`` and joins them.
+ */
+template <typename E>
+struct when_all_expected_fn {
+  /**
+   * @brief Launch the calls and return a tuple of their values or the first error.
+   */
+  template <lazy_expected<E>... L, std::size_t... I>
+  LF_STATIC_CALL auto operator()(auto /* unused */, std::tuple<L...> *calls, std::index_sequence<I...>)
+      LF_STATIC_CONST->task<std::expected<std::tuple<expected_value_t<typename L::result_type>...>, E>> {
+
+    using value_type = std::tuple<expected_value_t<typename L::result_type>...>;
+
+    constexpr std::size_t n = sizeof...(L);
+
+    expected_state<E> state;
+
+    std::tuple<eventually<typename L::result_type>...> slots;
+
+    // clang-format off
+
+    (co_await combinate<launch_tag<I, n>, modifier::none>(discard_t{}, expected_child_fn{})(
+        &state, &std::get<I>(slots), &std::get<I>(*calls)
+    ), ...);
+
+    // clang-format on
+
+    co_await lf::join;
+
+    if (state.failed.load(std::memory_order_relaxed)) {
+      LF_ASSERT(state.error.has_value());
+      co_return std::unexpected<E>{*std::move(state.error)};
+    }
+
+    co_return value_type{take_expected<typename L::result_type>(std::get<I>(slots))...};
+  }
+};
+
+// ---------------- Awaitables ---------------- //
+
+/**
+ * @brief A set of lazy calls, transformed into a `when_awaitable` by the promise's `await_transform`.
+ *
+ * @tparam Fn The async function that launches and joins the calls.
+ * @tparam R The result type of `Fn`.
+ */
+template <typename Fn, returnable R, some_lazy... L>
+struct [[nodiscard("co_await this!")]] when_packet {
+  /**
+   * @brief The calls.
+   */
+  std::tuple<L...> calls;
+};
+
+/**
+ * @brief An awaitable that calls `Fn` (with an internal return address) and rethrows its exception.
+ *
+ * This is a ``just_awaitable`` whose parent is set in the constructor such that it can be returned by value
+ * from an `await_transform`.
+ */
+template <returnable R>
+class [[nodiscard("co_await this!")]] when_awaitable : just_awaitable_base<R>, call_awaitable {
+ public:
+  /**
+   * @brief Call `packet`'s launcher as a child of `parent`.
+   */
+  template <typename Fn, some_lazy... L>
+  when_awaitable(frame *parent, when_packet<Fn, R, L...> &packet)
+      : call_awaitable{
+            {},
+            combinate<tag::call, modifier::none>(&this->ret, Fn{})(
+                &packet.calls, std::index_sequence_for<L...>{}
+            ),
+        } {
+    this->child->set_parent(parent);
+  }
+
+  using call_awaitable::await_ready;
+
+  using call_awaitable::await_suspend;
+
+  /**
+   * @brief Return the result of the launcher or rethrow the exception.
+   */
+  auto await_resume() -> R {
+
+    if (this->ret.has_exception()) {
+      std::rethrow_exception(std::move(this->ret).exception());
+    }
+
+    return *std::move(this->ret);
+  }
+};
+
+/**
+ * @brief Build a ``when_all`` packet.
+ */
+struct when_all_overload {
+  /**
+   * @brief Bundle the calls, their results will be returned as a tuple.
+   */
+  template <some_lazy... L>
+    requires (sizeof...(L) > 0)
+  LF_STATIC_CALL auto operator()(L... calls) LF_STATIC_CONST
+      ->when_packet<when_all_fn, std::tuple<when_value_t<typename L::result_type>...>, L...> {
+    return {{std::move(calls)...}};
+  }
+};
+
+/**
+ * @brief Build a ``when_any`` packet.
+ */
+struct when_any_overload {
+  /**
+   * @brief Bundle the calls, the result of the first to complete will be returned as a variant.
+   */
+  template <some_lazy... L>
+    requires (sizeof...(L) > 0) && (!std::is_reference_v<typename L::result_type> && ...)
+  LF_STATIC_CALL auto operator()(L... calls) LF_STATIC_CONST
+      ->when_packet<when_any_fn, std::variant<when_value_t<typename L::result_type>...>, L...> {
+    return {{std::move(calls)...}};
+  }
+};
+
+/**
+ * @brief The error type of a lazy call returning a ``std::expected``.
+ */
+template <some_lazy L>
+using lazy_error_t = typename detail::expected_impl<typename L::result_type>::error_type;
+
+/**
+ * @brief The type of a ``when_all_expected`` packet.
+ */
+template <some_lazy First, some_lazy... L>
+using expected_packet = when_packet<
+    when_all_expected_fn<lazy_error_t<First>>,
+    std::expected<std::tuple<expected_value_t<typename First::result_type>,
+                             expected_value_t<typename L::result_type>...>,
+                  lazy_error_t<First>>,
+    First,
+    L...>;
+
+/**
+ * @brief Build a ``when_all_expected`` packet.
+ */
+struct when_all_expected_overload {
+  /**
+   * @brief Bundle the calls, their values will be returned as a tuple or else the first error.
+   */
+  template <some_lazy First, some_lazy... L>
+    requires some_expected<typename First::result_type> && (lazy_expected<L, lazy_error_t<First>> && ...)
+  LF_STATIC_CALL auto operator()(First first, L... calls) LF_STATIC_CONST->expected_packet<First, L...> {
+    return {{std::move(first), std::move(calls)...}};
+  }
+};
+
+} // namespace impl
+
+inline namespace core {
+
+/**
+ * @brief A second-order functor, binds an async function to its arguments without invoking it.
+ *
+ * \rst
+ *
+ * The result must be passed directly to ``lf::when_all`` or ``lf::when_any``, the arguments are
+ * bound by reference.
+ *
+ * \endrst
+ */
+inline constexpr impl::bind_lazy lazy = {};
+
+/**
+ * @brief Run a set of async calls in parallel and collect their results.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <typename... R>
+ *    auto when_all(lazy_call<R>... calls) -> awaitable<std::tuple<R...>>;
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    auto [a, b, c] = co_await lf::when_all(lf::lazy(f)(x), lf::lazy(g)(y), lf::lazy(h)(z));
+ *
+ * This is equivalent to declaring a result for each call, forking all but the last call, calling the
+ * last and then joining. The calls are made from a child task hence, the ``co_await`` does not
+ * open a fork-join scope in the awaiting task and it can be used anywhere a ``lf::just`` can.
+ *
+ * Results of ``void`` calls are reported as ``std::monostate``. If any call throws then an
+ * exception is rethrown from the ``co_await`` after all the calls have completed.
+ *
+ * \endrst
+ */
+inline constexpr impl::when_all_overload when_all = {};
+
+/**
+ * @brief Run a set of async calls in parallel and return the result of the first to complete.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <typename... R>
+ *    auto when_any(lazy_call<R>... calls) -> awaitable<std::variant<R...>>;
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    std::variant result = co_await lf::when_any(lf::lazy(f)(x), lf::lazy(g)(y));
+ *
+ *    // result.index() is the index of the first call to complete.
+ *
+ * Each call is forked in a wrapper that claims the result when the call completes, the index of the
+ * variant is the index of the winning call. Libfork cannot interrupt a running task hence, cancellation
+ * is cooperative: calls that have not started when a sibling completes are skipped, the results of calls
+ * that complete later are discarded. The ``co_await`` resumes once every started call has completed.
+ *
+ * Results of ``void`` calls are reported as ``std::monostate``, reference results are not supported.
+ *
+ * \endrst
+ */
+inline constexpr impl::when_any_overload when_any = {};
+
+/**
+ * @brief Run a set of async calls returning ``std::expected`` in parallel and stop at the first error.
+ *
+ * \rst
+ *
+ * Effective call signature:
+ *
+ * .. code ::
+ *
+ *    template <typename... T, typename E>
+ *    auto when_all_expected(lazy_call<std::expected<T, E>>... calls)
+ *        -> awaitable<std::expected<std::tuple<T...>, E>>;
+ *
+ * Exemplary usage:
+ *
+ * .. code::
+ *
+ *    inline constexpr auto validate = [](auto validate, span data) -> lf::task<std::expected<void, err>> {
+ *
+ *      if (data.size() == 1) {
+ *        co_return check(data[0]);
+ *      }
+ *
+ *      auto [lhs, rhs] = split(data);
+ *
+ *      auto ok = co_await lf::when_all_expected(lf::lazy(validate)(lhs), lf::lazy(validate)(rhs));
+ *
+ *      if (!ok) {
+ *        co_return std::unexpected{ok.error()};
+ *      }
+ *
+ *      co_return {};
+ *    };
+ *
+ * This is the error-code counterpart of ``lf::when_all`` and it does not require exceptions, it is the
+ * recommended way to propagate errors through a fork-join tree when compiling with ``-fno-exceptions``.
+ * Each call is forked in a wrapper that publishes the first error to its siblings, calls that have not
+ * started when a sibling fails are skipped, hence an error anywhere in a recursive tree of
+ * ``when_all_expected`` prunes the remaining work. The ``co_await`` resumes once every started call has
+ * completed and yields either a tuple of the values (``void`` is reported as ``std::monostate``) or the
+ * first error. All calls must share the same error type.
+ *
+ * \endrst
+ */
+inline constexpr impl::when_all_expected_overload when_all_expected = {};
+
+} // namespace core
+
+} // namespace lf
+
+#endif /* F71F68C5_FDB9_4658_B122_0FCAAAE4D031 */
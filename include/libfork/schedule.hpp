@@ -10,7 +10,9 @@
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
 #include "libfork/schedule/busy_pool.hpp"
+#include "libfork/schedule/io.hpp"
 #include "libfork/schedule/lazy_pool.hpp"
+#include "libfork/schedule/sleep.hpp"
 #include "libfork/schedule/unit_pool.hpp"
 
 #include "libfork/schedule/ext/event_count.hpp"
@@ -18,6 +20,8 @@
 #include "libfork/schedule/ext/random.hpp"
 
 #include "libfork/schedule/impl/numa_context.hpp"
+#include "libfork/schedule/impl/reactor.hpp"
+#include "libfork/schedule/impl/timer_wheel.hpp"
 
 /**
  * @file scheduler.hpp
@@ -26,9 +26,10 @@
 #include "libfork/core/impl/utility.hpp"          // for checked_cast, k_cache_line
 #include "libfork/core/macro.hpp"                 // for LF_ASSERT, LF_ASSERT_NO_ASSUME, LF_LOG
 #include "libfork/core/scheduler.hpp"             // for scheduler
-#include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology
+#include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology, steal_policy
 #include "libfork/schedule/ext/random.hpp"        // for xoshiro, seed
 #include "libfork/schedule/impl/numa_context.hpp" // for numa_context
+#include "libfork/schedule/impl/timer_wheel.hpp"  // for timer_queue, tls_timers
 
 /**
  * @file busy_pool.hpp
@@ -63,6 +64,10 @@ struct busy_vars {
    * @brief Signal shutdown.
    */
   alignas(k_cache_line) std::atomic_flag stop;
+  /**
+   * @brief Deadlines of sleeping tasks.
+   */
+  alignas(k_cache_line) timer_queue timers;
 };
 
 /**
@@ -79,6 +84,8 @@ inline void busy_work(numa_topology::numa_node<impl::numa_context<busy_vars>> no
 
   my_context->init_worker_and_bind(nullary_function_t{[]() {}}, node); // Notification is a no-op.
 
+  tls_timers = &my_context->shared().timers;
+
   // Wait for everyone to have set up their numa_vars. If this throws an exception then
   // program terminates due to the noexcept marker.
   my_context->shared().latch_start.arrive_and_wait();
@@ -88,12 +95,15 @@ inline void busy_work(numa_topology::numa_node<impl::numa_context<busy_vars>> no
     my_context->shared().stop.test_and_set(std::memory_order_release);
     my_context->shared().latch_stop.arrive_and_wait();
     my_context->finalize_worker();
+    tls_timers = nullptr;
   };
 
   // -------
 
   while (!my_context->shared().stop.test(std::memory_order_acquire)) {
 
+    my_context->shared().timers.poll();
+
     if (submit_handle submissions = my_context->try_pop_all()) {
       resume(submissions);
       continue;
@@ -156,13 +166,15 @@ class busy_pool {
    *
    * @param n The number of worker threads to create, defaults to the number of hardware threads.
    * @param strategy The numa strategy for distributing workers.
+   * @param policy The policy idle workers use to select a victim, leapfrogging is opt-in.
    */
   explicit busy_pool(std::size_t n = std::thread::hardware_concurrency(),
-                     numa_strategy strategy = numa_strategy::fan)
+                     numa_strategy strategy = numa_strategy::fan,
+                     steal_policy policy = steal_policy::random)
       : m_num_threads(n) {
 
     for (std::size_t i = 0; i < n; ++i) {
-      m_worker.push_back(std::make_shared<impl::numa_context<impl::busy_vars>>(m_rng, m_share));
+      m_worker.push_back(std::make_shared<impl::numa_context<impl::busy_vars>>(m_rng, m_share, policy));
       m_rng.long_jump();
     }
 
@@ -16,11 +16,14 @@
 
 // The contents of this file have been adapted from https://github.com/facebook/folly
 
-#include <atomic>     // for atomic, memory_order_acq_rel, memory_order_seq_cst
-#include <bit>        // for endian
-#include <cstddef>    // for size_t
-#include <cstdint>    // for uint64_t, uint32_t
-#include <functional> // for invoke
+#include <atomic>             // for atomic, memory_order_acq_rel, memory_order_seq_cst
+#include <bit>                // for endian
+#include <chrono>             // for steady_clock
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <cstdint>            // for uint64_t, uint32_t
+#include <functional>         // for invoke
+#include <mutex>              // for mutex, unique_lock, lock_guard
 
 #include "libfork/core/impl/utility.hpp" // for immovable
 #include "libfork/core/macro.hpp"        // for LF_ASSERT, LF_CATCH_ALL, LF_RETHROW, LF_TRY
@@ -136,6 +139,13 @@ class event_count : impl::immovable<event_count> {
    * @brief Wait for a notification, this blocks the current thread.
    */
   auto wait(key in_key) noexcept -> void;
+  /**
+   * @brief Wait for a notification or until `deadline` passes, this blocks the current thread.
+   *
+   * Timed waits are expected to be rare (e.g. a single worker servicing timers) hence, they are
+   * implemented with a condition variable that is only touched by notifiers when a timed waiter exists.
+   */
+  auto wait_until(key in_key, std::chrono::steady_clock::time_point deadline) noexcept -> void;
 
   /**
    * Wait for ``condition()`` to become true.
@@ -171,19 +181,39 @@ class event_count : impl::immovable<event_count> {
   static constexpr std::uint64_t k_add_epoch = static_cast<std::uint64_t>(1) << k_epoch_shift;
   static constexpr std::uint64_t k_waiter_mask = k_add_epoch - 1;
 
+  /**
+   * @brief Wake any timed waiters, called after the epoch has been incremented.
+   */
+  auto notify_timed() noexcept -> void;
+
   // Stores the epoch in the most significant 32 bits and the waiter count in the least significant 32 bits.
   std::atomic<std::uint64_t> m_val = 0;
+
+  // Number of threads in wait_until(), these block on the condition variable instead of the epoch.
+  std::atomic<std::uint32_t> m_timed = 0;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
 };
 
+inline void event_count::notify_timed() noexcept {
+  // Pairs with the seq_cst increment of m_timed in wait_until().
+  if (m_timed.load(std::memory_order_seq_cst) > 0) [[unlikely]] {
+    { std::lock_guard lock{m_mutex}; }
+    m_cond.notify_all();
+  }
+}
+
 inline void event_count::notify_one() noexcept {
-  if (m_val.fetch_add(k_add_epoch, std::memory_order_acq_rel) & k_waiter_mask) [[unlikely]] { // NOLINT
+  if (m_val.fetch_add(k_add_epoch, std::memory_order_seq_cst) & k_waiter_mask) [[unlikely]] { // NOLINT
     epoch()->notify_one();
+    notify_timed();
   }
 }
 
 inline void event_count::notify_all() noexcept {
-  if (m_val.fetch_add(k_add_epoch, std::memory_order_acq_rel) & k_waiter_mask) [[unlikely]] { // NOLINT
+  if (m_val.fetch_add(k_add_epoch, std::memory_order_seq_cst) & k_waiter_mask) [[unlikely]] { // NOLINT
     epoch()->notify_all();
+    notify_timed();
   }
 }
 
@@ -214,6 +244,30 @@ inline void event_count::wait(key in_key) noexcept {
   LF_ASSERT((prev & k_waiter_mask) != 0);
 }
 
+inline void event_count::wait_until(key in_key, std::chrono::steady_clock::time_point deadline) noexcept {
+
+  m_timed.fetch_add(1, std::memory_order_seq_cst);
+
+  // clang-format off
+
+  LF_TRY {
+    std::unique_lock lock{m_mutex};
+    m_cond.wait_until(lock, deadline, [&] {
+      return epoch()->load(std::memory_order_seq_cst) != in_key.m_epoch;
+    });
+  } LF_CATCH_ALL {
+    // Locking can only fail due to a system error, treat it as a spurious wakeup.
+  }
+
+  // clang-format on
+
+  m_timed.fetch_sub(1, std::memory_order_relaxed);
+
+  auto prev = m_val.fetch_add(k_sub_waiter, std::memory_order_seq_cst);
+
+  LF_ASSERT((prev & k_waiter_mask) != 0);
+}
+
 template <class Pred>
   requires std::is_invocable_r_v<bool, Pred const &>
 void event_count::await(Pred const &condition) noexcept(std::is_nothrow_invocable_r_v<bool, Pred const &>) {
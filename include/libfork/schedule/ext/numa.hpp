@@ -108,6 +108,37 @@ enum class numa_strategy {
    * @brief Fill up each numa node sequentially (ignoring SMT).
    */
   seq,
+  /**
+   * @brief Put at most one worker on each physical core, never use SMT siblings.
+   *
+   * If more workers are requested than there are cores then workers are stacked on the first processing
+   * unit of each core.
+   */
+  core,
+  /**
+   * @brief Put one worker on each physical core before using any SMT siblings.
+   *
+   * Workers only spill onto the hyperthreads of a core once every core is occupied.
+   */
+  smt,
+};
+
+/**
+ * @brief Enum to control how idle workers select a victim to steal from.
+ */
+enum class steal_policy {
+  /**
+   * @brief Steal from random victims, weighted by their numa distance.
+   */
+  random,
+  /**
+   * @brief First try to steal back from the last worker that stole from us, then steal at random.
+   *
+   * A worker's deque only contains the continuations of its own tasks hence, the last thief is executing
+   * (an ancestor of) this worker's work. Stealing back from it keeps a worker within its own subtree which
+   * improves locality in deep unbalanced trees. Leapfrogging is limited to the closest numa domain.
+   */
+  leapfrog,
 };
 
 /**
@@ -168,6 +199,12 @@ class numa_topology {
      * @brief  The index of the numa node this handle belongs to, on [0, n).
      */
     std::size_t numa = 0;
+    /**
+     * @brief  The index of the physical core this handle belongs to, on [0, n).
+     *
+     * Handles that share a core are SMT siblings.
+     */
+    std::size_t core = 0;
   };
 
   /**
@@ -177,6 +214,8 @@ class numa_topology {
    * Here the definition of "uniformly" depends on `strategy`. If `strategy == numa_strategy::seq` we try
    * to use the minimum number of numa nodes then divided each node such that each PU has as much cache as
    * possible. If `strategy == numa_strategy::fan` we try and maximize the amount of cache each PI gets.
+   * The `numa_strategy::core` and `numa_strategy::smt` strategies spread over physical cores first, see
+   * `numa_strategy` for details.
    *
    * If this topology is empty then this function returns a vector of `n` empty handles.
    */
@@ -301,6 +340,57 @@ inline auto get_numa_index(hwloc_topology *topo, hwloc_bitmap_s *bitmap) -> hwlo
   return obj->gp_index;
 }
 
+/**
+ * @brief Get a unique identifier for the physical core that contains `bitmap`.
+ *
+ * If the topology has no cores then the identifier of the covering object is returned.
+ */
+inline auto get_core_index(hwloc_topology *topo, hwloc_bitmap_s *bitmap) -> hwloc_uint64_t {
+
+  LF_ASSERT(topo);
+  LF_ASSERT(bitmap);
+
+  hwloc_obj *obj = hwloc_get_obj_covering_cpuset(topo, bitmap);
+
+  if (obj == nullptr) {
+    LF_THROW(hwloc_error{"failed to find an object covering a bitmap"});
+  }
+
+  if (obj->type == HWLOC_OBJ_CORE) {
+    return obj->gp_index;
+  }
+
+  if (hwloc_obj *core = hwloc_get_ancestor_obj_by_type(topo, HWLOC_OBJ_CORE, obj); core != nullptr) {
+    return core->gp_index;
+  }
+
+  return obj->gp_index;
+}
+
+/**
+ * @brief Reduce `bitmap` to its `n`th set bit, wrapping around if `bitmap` has fewer bits.
+ */
+inline auto singlify_nth(hwloc_bitmap_s *bitmap, unsigned int n) -> int {
+
+  LF_ASSERT(bitmap);
+
+  int weight = hwloc_bitmap_weight(bitmap);
+
+  if (weight <= 0) {
+    return hwloc_bitmap_singlify(bitmap);
+  }
+
+  int bit = hwloc_bitmap_first(bitmap);
+
+  for (unsigned int i = 0; i < n % static_cast<unsigned int>(weight); ++i) {
+    bit = hwloc_bitmap_next(bitmap, bit);
+  }
+
+  LF_ASSERT(bit >= 0);
+
+  return hwloc_bitmap_only(bitmap, static_cast<unsigned int>(bit));
+}
+
 inline auto numa_topology::split(std::size_t n, numa_strategy strategy) const -> std::vector<numa_handle> {
 
   if (n < 1) {
@@ -330,6 +420,17 @@ inline auto numa_topology::split(std::size_t n, numa_strategy strategy) const ->
     roots.push_back(hwloc_get_root_obj(m_topology.get()));
   }
 
+  // For the core-aware strategies we stop hwloc from descending below the cores, this means we
+  // get every core before any core is repeated.
+
+  int until = INT_MAX;
+
+  if (strategy == numa_strategy::core || strategy == numa_strategy::smt) {
+    if (int depth = hwloc_get_type_depth(m_topology.get(), HWLOC_OBJ_CORE); depth >= 0) {
+      until = depth;
+    }
+  }
+
   // Now we distribute over the cores in each numa package, NOTE:  hwloc_distrib
   // gives us owning pointers (not in the docs, but it does!).
 
@@ -338,7 +439,7 @@ inline auto numa_topology::split(std::size_t n, numa_strategy strategy) const ->
   auto r_size = static_cast<unsigned int>(roots.size());
   auto s_size = static_cast<unsigned int>(sets.size());
 
-  if (hwloc_distrib(m_topology.get(), roots.data(), r_size, sets.data(), s_size, INT_MAX, 0) != 0) {
+  if (hwloc_distrib(m_topology.get(), roots.data(), r_size, sets.data(), s_size, until, 0) != 0) {
     LF_THROW(hwloc_error{"unknown hwloc error when distributing over a topology"});
   }
 
@@ -346,6 +447,10 @@ inline auto numa_topology::split(std::size_t n, numa_strategy strategy) const ->
   std::vector<unique_cpup> singlets{sets.begin(), sets.end()};
 
   std::map<hwloc_uint64_t, std::size_t> numa_map;
+  std::map<hwloc_uint64_t, std::size_t> core_map;
+
+  // Number of times each core has been handed out, used to pick SMT siblings.
+  std::map<hwloc_uint64_t, unsigned int> core_uses;
 
   return impl::map(std::move(singlets), [&](unique_cpup &&singlet) -> numa_handle {
     //
@@ -353,20 +458,33 @@ inline auto numa_topology::split(std::size_t n, numa_strategy strategy) const ->
       LF_THROW(hwloc_error{"hwloc_distrib returned a nullptr"});
     }
 
-    if (hwloc_bitmap_singlify(singlet.get()) != 0) {
+    if (strategy == numa_strategy::smt) {
+      // Each use of a core takes the next processing unit of that core.
+      hwloc_uint64_t core_index = get_core_index(m_topology.get(), singlet.get());
+
+      if (singlify_nth(singlet.get(), core_uses[core_index]++) != 0) {
+        LF_THROW(hwloc_error{"unknown hwloc error when singlify a bitmap"});
+      }
+    } else if (hwloc_bitmap_singlify(singlet.get()) != 0) {
       LF_THROW(hwloc_error{"unknown hwloc error when singlify a bitmap"});
     }
 
     hwloc_uint64_t numa_index = get_numa_index(m_topology.get(), singlet.get());
+    hwloc_uint64_t core_index = get_core_index(m_topology.get(), singlet.get());
 
     if (!numa_map.contains(numa_index)) {
       numa_map[numa_index] = numa_map.size();
     }
 
+    if (!core_map.contains(core_index)) {
+      core_map[core_index] = core_map.size();
+    }
+
     return {
         m_topology,
         std::move(singlet),
         numa_map[numa_index],
+        core_map[core_index],
     };
   });
 }
@@ -498,7 +616,15 @@ inline void numa_topology::numa_handle::bind() const {
 
 inline auto
 numa_topology::split(std::size_t n, numa_strategy /* strategy */) const -> std::vector<numa_handle> {
-  return std::vector<numa_handle>(n);
+
+  std::vector<numa_handle> handles(n);
+
+  // Without hwloc we have to assume every worker gets its own core.
+  for (std::size_t i = 0; i < n; ++i) {
+    handles[i].core = i;
+  }
+
+  return handles;
 }
 
 template <typename T>
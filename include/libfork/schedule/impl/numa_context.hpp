@@ -9,7 +9,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
-#include <algorithm> // for shuffle
+#include <algorithm> // for any_of, shuffle
 #include <cstddef>   // for size_t
 #include <memory>    // for shared_ptr
 #include <random>    // for discrete_distribution
@@ -17,12 +17,12 @@
 #include <vector>    // for vector
 
 #include "libfork/core/ext/context.hpp"    // for worker_context, nullary_function_t
-#include "libfork/core/ext/deque.hpp"      // for err
+#include "libfork/core/ext/deque.hpp"      // for err, steal_t
 #include "libfork/core/ext/handles.hpp"    // for submit_handle, task_handle
 #include "libfork/core/ext/tls.hpp"        // for finalize, worker_init
 #include "libfork/core/impl/utility.hpp"   // for non_null, map
 #include "libfork/core/macro.hpp"          // for LF_ASSERT, LF_LOG, LF_CATCH_ALL, LF_RETHROW
-#include "libfork/schedule/ext/numa.hpp"   // for numa_topology
+#include "libfork/schedule/ext/numa.hpp"   // for numa_topology, steal_policy
 #include "libfork/schedule/ext/random.hpp" // for xoshiro
 
 /**
@@ -48,6 +48,14 @@ struct numa_context {
    * @brief The number of steal attempts we will make per target in a `try_steal` operation.
    */
   static constexpr std::size_t k_steal_attempts_per_target = 32;
+  /**
+   * @brief The number of attempts to steal back from our last thief, before stealing at random.
+   */
+  static constexpr std::size_t k_leapfrog_attempts = 4;
+  /**
+   * @brief If true steal back from our last thief before stealing at random, see `steal_policy`.
+   */
+  bool m_leapfrog;
   /**
    * @brief Thread-local RNG.
    */
@@ -73,12 +81,24 @@ struct numa_context {
    */
   std::vector<numa_context *> m_neigh;
 
+  /**
+   * @brief Test if `context` belongs to one of our first order neighbors.
+   */
+  [[nodiscard]] auto is_close(worker_context const *context) const noexcept -> bool {
+    return std::ranges::any_of(m_close, [=](numa_context const *neigh) {
+      return neigh->m_context == context;
+    });
+  }
+
  public:
   /**
    * @brief Construct a new numa context object.
    */
-  numa_context(xoshiro const &rng, std::shared_ptr<Shared> shared)
-      : m_rng(rng),
+  numa_context(xoshiro const &rng,
+               std::shared_ptr<Shared> shared,
+               steal_policy policy = steal_policy::random)
+      : m_leapfrog(policy == steal_policy::leapfrog),
+        m_rng(rng),
         m_shared{std::move(non_null(shared))} {}
 
   /**
@@ -194,6 +214,9 @@ struct numa_context {
       switch (err) {                                                                                         \
         case lf::err::none:                                                                                  \
           LF_LOG("Stole task from {}", (void *)context);                                                     \
+          if (m_leapfrog) {                                                                                  \
+            context->m_context->set_last_thief(m_context);                                                   \
+          }                                                                                                  \
           return task;                                                                                       \
         case lf::err::lost:                                                                                  \
           /* We don't retry here as we don't want to cause contention */                                     \
@@ -205,6 +228,21 @@ struct numa_context {
       }                                                                                                      \
     } while (false)
 
+    // Leapfrogging: steal back from the worker that stole our continuation, its deque holds our subtree.
+    if (worker_context *thief = m_leapfrog ? m_context->last_thief() : nullptr; thief && is_close(thief)) {
+      for (std::size_t i = 0; i < k_leapfrog_attempts; ++i) {
+        if (auto [err, task] = thief->try_steal(); err == lf::err::none) {
+          LF_LOG("Leapfrog steal from {}", (void *)thief);
+          thief->set_last_thief(m_context);
+          return task;
+        } else if (err == lf::err::empty) {
+          // Our subtree is exhausted, don't keep probing a stale thief.
+          m_context->clear_last_thief(thief);
+          break;
+        }
+      }
+    }
+
     std::ranges::shuffle(m_close, m_rng);
 
     // Check all of the closest numa domain.
@@ -0,0 +1,617 @@
+#ifndef F1D3A6C2_7B4E_4C1A_9E0D_2A5B8C7E4F61
+#define F1D3A6C2_7B4E_4C1A_9E0D_2A5B8C7E4F61
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm> // for max
+#include <atomic>    // for atomic, atomic_ref, memory_order_acquire, memory_order_release
+#include <chrono>    // for steady_clock, nanoseconds, seconds
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint8_t, uint32_t, uint64_t, int64_t
+#include <mutex>     // for lock_guard
+#include <optional>  // for optional
+
+#include "libfork/core/impl/spin_lock.hpp" // for spin_lock
+#include "libfork/core/impl/utility.hpp"   // for immovable
+#include "libfork/core/impl/waiter.hpp"    // for waiter, waiter_queue
+#include "libfork/core/macro.hpp"          // for LF_ASSERT
+
+#ifdef __has_include
+  #if defined(LF_USE_URING) && not __has_include(<linux/io_uring.h>)
+    #error "LF_USE_URING is defined but <linux/io_uring.h> is not available"
+  #endif
+#endif
+
+#ifdef LF_USE_URING
+  #include <cerrno>           // for errno, EINTR
+  #include <linux/io_uring.h> // for io_uring_params, io_uring_sqe, io_uring_cqe, IORING_...
+  #include <sys/mman.h>       // for mmap, munmap, MAP_FAILED, MAP_SHARED, MAP_POPULATE
+  #include <sys/syscall.h>    // for __NR_io_uring_setup, __NR_io_uring_enter
+  #include <unistd.h>         // for syscall, close
+#endif
+
+/**
+ * @file reactor.hpp
+ *
+ * @brief An optional io_uring reactor that idle workers block on while I/O is in flight.
+ */
+
+namespace lf {
+
+namespace impl {
+
+/**
+ * @brief Returns `true` if libfork was built with io_uring support.
+ */
+inline auto uring_support() -> bool {
+#ifdef LF_USE_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief The kinds of operation a reactor can perform.
+ */
+enum class io_op : std::uint8_t {
+  /**
+   * @brief Equivalent to `pread`.
+   */
+  read,
+  /**
+   * @brief Equivalent to `pwrite`.
+   */
+  write,
+};
+
+/**
+ * @brief A coroutine waiting for an I/O operation to complete.
+ */
+struct io_node : waiter {
+  /**
+   * @brief The operation to perform.
+   */
+  io_op op = io_op::read;
+  /**
+   * @brief The file descriptor to operate on.
+   */
+  int fd = -1;
+  /**
+   * @brief The buffer to read into/write from.
+   */
+  void *buf = nullptr;
+  /**
+   * @brief The number of bytes to transfer.
+   */
+  std::uint32_t len = 0;
+  /**
+   * @brief The offset in the file, `k_stream` to use (and update) the file position like `read`/`write`.
+   */
+  std::uint64_t offset = 0;
+  /**
+   * @brief The offset for non-seekable files (pipes, sockets, etc.)
+   */
+  static constexpr std::uint64_t k_stream = static_cast<std::uint64_t>(-1);
+  /**
+   * @brief The number of bytes transferred or, a negated `errno`.
+   */
+  std::int64_t result = 0;
+};
+
+/**
+ * @brief An io_uring instance shared by the workers of a pool.
+ *
+ * Any worker may submit operations, completions are reaped by whichever worker polls the reactor. While
+ * there are operations in flight (at most) one idle worker, the leader, blocks on the ring instead of the
+ * pool's event count, notifiers must call `interrupt()` after notifying to wake the leader.
+ *
+ * If libfork was built without `LF_USE_URING` (or the kernel refuses to create a ring) the reactor is
+ * invalid and all its operations are no-ops.
+ */
+class reactor : immovable<reactor> {
+ public:
+  /**
+   * @brief The clock used for timeouts.
+   */
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * @brief The right to block on the ring, released on destruction.
+   */
+  class [[nodiscard]] lease : immovable<lease> {
+   public:
+    /**
+     * @brief Test if this lease is held.
+     */
+    explicit operator bool() const noexcept { return m_reactor != nullptr; }
+
+    /**
+     * @brief Block until a completion, an `interrupt()` or `deadline`, this may wake spuriously.
+     */
+    void wait(std::optional<clock::time_point> deadline) const noexcept;
+
+    /**
+     * @brief Release the lease early, this is idempotent.
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Release the lease.
+     */
+    ~lease() noexcept { release(); }
+
+   private:
+    friend class reactor;
+
+    explicit lease(reactor *owner) noexcept : m_reactor{owner} {}
+
+    reactor *m_reactor;
+  };
+
+  /**
+   * @brief Attempt to create an io_uring instance.
+   */
+  reactor() noexcept;
+
+  /**
+   * @brief Destroy the ring, no operations may be in flight.
+   */
+  ~reactor() noexcept;
+
+  /**
+   * @brief Test if this reactor can accept operations.
+   */
+  [[nodiscard]] auto valid() const noexcept -> bool;
+
+  /**
+   * @brief Test if there are operations in flight (or waiting for space in the ring).
+   */
+  [[nodiscard]] auto pending() const noexcept -> bool {
+    return m_inflight.load(std::memory_order_relaxed) > 0;
+  }
+
+  /**
+   * @brief Submit an operation, requires `valid()`, after this call `node` may have been woken.
+   *
+   * If the ring is full the operation is parked on an overflow queue and submitted when a completion is
+   * reaped, the submitting worker never blocks.
+   */
+  void submit(io_node *node) noexcept;
+
+  /**
+   * @brief Wake every coroutine whose operation has completed and submit parked operations.
+   */
+  void poll() noexcept;
+
+  /**
+   * @brief Attempt to become the worker that blocks on the ring.
+   *
+   * This only succeeds if there are operations in flight and no other worker holds the lease.
+   */
+  [[nodiscard]] auto try_lead() noexcept -> lease;
+
+  /**
+   * @brief Wake the leader (if any), must be called after notifying the pool's event count.
+   */
+  void interrupt() noexcept;
+
+ private:
+#ifdef LF_USE_URING
+
+  static constexpr unsigned k_entries = 256;
+
+  /**
+   * @brief Push an SQE and submit it, requires `m_sq_lock`.
+   *
+   * Returns false if the ring is full or the submission failed, in which case the SQE is not in the ring.
+   */
+  template <typename Fn>
+  auto push(Fn fill) noexcept -> bool;
+
+  /**
+   * @brief Push a read/write SQE for `node`, requires `m_sq_lock`.
+   *
+   * Returns false if there is no room in the ring or the submission failed.
+   */
+  auto try_push(io_node *node) noexcept -> bool;
+
+  /**
+   * @brief Collect the completed nodes then, move parked nodes into the ring, requires `m_cq_lock`.
+   */
+  auto reap() noexcept -> waiter_queue<io_node>;
+
+  int m_fd = -1;
+
+  void *m_sq_ring = nullptr;
+  std::size_t m_sq_size = 0;
+  void *m_cq_ring = nullptr;
+  std::size_t m_cq_size = 0;
+  io_uring_sqe *m_sqes = nullptr;
+  std::size_t m_sqes_size = 0;
+
+  unsigned *m_sq_head = nullptr;
+  unsigned *m_sq_tail = nullptr;
+  unsigned *m_sq_array = nullptr;
+  unsigned m_sq_mask = 0;
+  unsigned m_sq_entries = 0;
+
+  unsigned *m_cq_head = nullptr;
+  unsigned *m_cq_tail = nullptr;
+  io_uring_cqe *m_cqes = nullptr;
+  unsigned m_cq_mask = 0;
+
+  spin_lock m_sq_lock;
+  spin_lock m_cq_lock;
+  std::atomic<bool> m_leading = false;
+  std::atomic<bool> m_poked = false;
+
+  /**
+   * @brief Operations that did not fit in the ring, requires `m_sq_lock`.
+   */
+  waiter_queue<io_node> m_overflow;
+  /**
+   * @brief The number of read/write operations in the ring.
+   */
+  std::atomic<std::size_t> m_queued = 0;
+
+#endif
+
+  /**
+   * @brief The number of submitted operations that have not completed, including parked operations.
+   */
+  std::atomic<std::size_t> m_inflight = 0;
+};
+
+/**
+ * @brief The reactor of the pool that owns the calling worker, `nullptr` if it has none.
+ */
+inline thread_local reactor *tls_reactor = nullptr;
+
+// ---------------------------- Implementation ---------------------------- //
+
+#ifdef LF_USE_URING
+
+inline reactor::reactor() noexcept {
+
+  io_uring_params params{};
+
+  int fd = static_cast<int>(::syscall(__NR_io_uring_setup, k_entries, &params));
+
+  if (fd < 0) {
+    return;
+  }
+
+  // Timeouts need EXT_ARG and, we rely on the kernel buffering an overflowing CQ.
+  if ((params.features & IORING_FEAT_EXT_ARG) == 0 || (params.features & IORING_FEAT_NODROP) == 0) {
+    ::close(fd);
+    return;
+  }
+
+  m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+  bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+  if (single) {
+    m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+  }
+
+  constexpr int prot = PROT_READ | PROT_WRITE;
+  constexpr int flags = MAP_SHARED | MAP_POPULATE;
+
+  void *sq_ring = ::mmap(nullptr, m_sq_size, prot, flags, fd, IORING_OFF_SQ_RING);
+  void *cq_ring = single ? sq_ring : ::mmap(nullptr, m_cq_size, prot, flags, fd, IORING_OFF_CQ_RING);
+  void *sqes = ::mmap(nullptr, m_sqes_size, prot, flags, fd, IORING_OFF_SQES);
+
+  if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+
+    auto unmap = [](void *ptr, std::size_t size) {
+      if (ptr != MAP_FAILED) {
+        ::munmap(ptr, size);
+      }
+    };
+
+    unmap(sqes, m_sqes_size);
+    unmap(single ? MAP_FAILED : cq_ring, m_cq_size);
+    unmap(sq_ring, m_sq_size);
+    ::close(fd);
+    return;
+  }
+
+  auto *sq = static_cast<std::byte *>(sq_ring);
+  auto *cq = static_cast<std::byte *>(cq_ring);
+
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  m_sq_head = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+  m_sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+  m_sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+  m_sq_mask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+  m_sq_entries = params.sq_entries;
+
+  m_cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+  m_cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+  m_cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+  m_cq_mask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  m_sq_ring = sq_ring;
+  m_cq_ring = cq_ring;
+  m_sqes = static_cast<io_uring_sqe *>(sqes);
+  m_fd = fd;
+}
+
+inline reactor::~reactor() noexcept {
+
+  LF_ASSERT(!pending());
+
+  if (m_fd < 0) {
+    return;
+  }
+
+  ::munmap(m_sqes, m_sqes_size);
+
+  if (m_cq_ring != m_sq_ring) {
+    ::munmap(m_cq_ring, m_cq_size);
+  }
+
+  ::munmap(m_sq_ring, m_sq_size);
+  ::close(m_fd);
+}
+
+inline auto reactor::valid() const noexcept -> bool { return m_fd >= 0; }
+
+template <typename Fn>
+auto reactor::push(Fn fill) noexcept -> bool {
+
+  unsigned head = std::atomic_ref{*m_sq_head}.load(std::memory_order_acquire);
+  unsigned tail = *m_sq_tail; // Only ever written by us.
+
+  if (tail - head >= m_sq_entries) {
+    return false;
+  }
+
+  unsigned index = tail & m_sq_mask;
+
+  m_sqes[index] = {};
+  fill(m_sqes[index]);
+  m_sq_array[index] = index;
+
+  std::atomic_ref{*m_sq_tail}.store(tail + 1, std::memory_order_release);
+
+  // Every push either submits its entry or retracts it, hence the kernel has consumed all earlier entries.
+  for (;;) {
+
+    long ret = ::syscall(__NR_io_uring_enter, m_fd, tail + 1 - head, 0, 0, nullptr, 0);
+
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+
+    head = std::atomic_ref{*m_sq_head}.load(std::memory_order_acquire);
+
+    if (head == tail + 1) {
+      return true;
+    }
+
+    if (ret < 0) {
+      // E.g. EBUSY/EAGAIN, the entry was not consumed so retract it, the caller will fall back.
+      std::atomic_ref{*m_sq_tail}.store(tail, std::memory_order_release);
+      return false;
+    }
+  }
+}
+
+inline auto reactor::try_push(io_node *node) noexcept -> bool {
+
+  // Bound the number of completions (including the leader's pokes) to the size of the CQ.
+  if (m_queued.fetch_add(1, std::memory_order_relaxed) >= m_sq_entries) {
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  bool ok = push([node](io_uring_sqe &sqe) {
+    sqe.opcode = node->op == io_op::read ? IORING_OP_READ : IORING_OP_WRITE;
+    sqe.fd = node->fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(node->buf); // NOLINT
+    sqe.len = node->len;
+    sqe.off = node->offset;
+    sqe.user_data = reinterpret_cast<std::uint64_t>(node); // NOLINT
+  });
+
+  // If pushed we may already have been woken, cannot touch `node`.
+
+  if (!ok) {
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  return ok;
+}
+
+inline void reactor::submit(io_node *node) noexcept {
+
+  LF_ASSERT(valid());
+
+  // Before the push such that a leader cannot observe the completion before the submission.
+  m_inflight.fetch_add(1, std::memory_order_relaxed);
+
+  std::lock_guard lock{m_sq_lock};
+
+  // Preserve the submission order of parked operations.
+  if (m_overflow.empty() && try_push(node)) {
+    return;
+  }
+
+  // The ring is full, the next reap will submit it.
+  m_overflow.push(node);
+}
+
+inline auto reactor::reap() noexcept -> waiter_queue<io_node> {
+
+  waiter_queue<io_node> done;
+
+  unsigned head = *m_cq_head; // Only ever written by the holder of `m_cq_lock`.
+  unsigned tail = std::atomic_ref{*m_cq_tail}.load(std::memory_order_acquire);
+
+  std::size_t count = 0;
+
+  for (; head != tail; ++head) {
+
+    io_uring_cqe const &cqe = m_cqes[head & m_cq_mask];
+
+    if (cqe.user_data == 0) {
+      // A poke from interrupt(), any later interrupt must send a new one.
+      m_poked.store(false, std::memory_order_release);
+    } else {
+      auto *node = reinterpret_cast<io_node *>(cqe.user_data); // NOLINT
+      node->result = cqe.res;
+      done.push(node);
+      count += 1;
+    }
+  }
+
+  std::atomic_ref{*m_cq_head}.store(tail, std::memory_order_release);
+
+  m_queued.fetch_sub(count, std::memory_order_relaxed);
+  m_inflight.fetch_sub(count, std::memory_order_relaxed);
+
+  // Fill the freed slots with parked operations.
+  std::lock_guard lock{m_sq_lock};
+
+  // A pushed node cannot be woken until the next reap, we hold `m_cq_lock`.
+  while (!m_overflow.empty() && try_push(m_overflow.front())) {
+    [[maybe_unused]] io_node *node = m_overflow.pop();
+  }
+
+  return done;
+}
+
+inline void reactor::poll() noexcept {
+
+  if (!valid()) {
+    return;
+  }
+
+  unsigned head = std::atomic_ref{*m_cq_head}.load(std::memory_order_relaxed);
+
+  // If nothing has completed parked operations are still waiting for a slot, unless the ring is empty.
+  if (head == std::atomic_ref{*m_cq_tail}.load(std::memory_order_acquire) &&
+      (m_queued.load(std::memory_order_relaxed) > 0 || m_inflight.load(std::memory_order_relaxed) == 0)) {
+    return;
+  }
+
+  // If this fails then someone else is reaping or the leader will reap when it wakes.
+  if (!m_cq_lock.try_lock()) {
+    return;
+  }
+
+  waiter_queue<io_node> done = reap();
+
+  m_cq_lock.unlock();
+
+  while (io_node *node = done.pop()) {
+    node->wake();
+  }
+}
+
+inline auto reactor::try_lead() noexcept -> lease {
+
+  if (!valid() || !pending() || !m_cq_lock.try_lock()) {
+    return lease{nullptr};
+  }
+
+  // Pairs with the seq_cst load in interrupt().
+  m_leading.store(true, std::memory_order_seq_cst);
+
+  return lease{this};
+}
+
+inline void reactor::interrupt() noexcept {
+
+  if (!m_leading.load(std::memory_order_seq_cst)) {
+    return;
+  }
+
+  if (m_poked.exchange(true, std::memory_order_acq_rel)) {
+    // A poke is already in the CQ.
+    return;
+  }
+
+  bool ok = [&] {
+    std::lock_guard lock{m_sq_lock};
+    return push([](io_uring_sqe &sqe) {
+      sqe.opcode = IORING_OP_NOP;
+      sqe.user_data = 0;
+    });
+  }();
+
+  if (!ok) {
+    m_poked.store(false, std::memory_order_release);
+  }
+}
+
+inline void reactor::lease::wait(std::optional<clock::time_point> deadline) const noexcept {
+
+  LF_ASSERT(m_reactor);
+
+  __kernel_timespec spec{};
+  io_uring_getevents_arg arg{};
+
+  if (deadline) {
+    auto rel = std::max(clock::duration::zero(), *deadline - clock::now());
+    auto sec = std::chrono::floor<std::chrono::seconds>(rel);
+    spec.tv_sec = sec.count();
+    spec.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(rel - sec).count();
+    arg.ts = reinterpret_cast<std::uint64_t>(&spec); // NOLINT
+  }
+
+  constexpr unsigned flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+
+  // Returns immediately if the CQ is non-empty, errors (EINTR, ETIME, ...) are spurious wake-ups.
+  ::syscall(__NR_io_uring_enter, m_reactor->m_fd, 0, 1, flags, &arg, sizeof(arg));
+}
+
+inline void reactor::lease::release() noexcept {
+  if (m_reactor != nullptr) {
+    m_reactor->m_leading.store(false, std::memory_order_release);
+    m_reactor->m_cq_lock.unlock();
+    m_reactor = nullptr;
+  }
+}
+
+#else
+
+inline reactor::reactor() noexcept = default;
+
+inline reactor::~reactor() noexcept = default;
+
+inline auto reactor::valid() const noexcept -> bool { return false; }
+
+inline void reactor::submit(io_node * /* unused */) noexcept { LF_ASSERT(false && "Unreachable"); }
+
+inline void reactor::poll() noexcept {}
+
+inline auto reactor::try_lead() noexcept -> lease { return lease{nullptr}; }
+
+inline void reactor::interrupt() noexcept {}
+
+inline void reactor::lease::wait(std::optional<clock::time_point> /* unused */) const noexcept {}
+
+inline void reactor::lease::release() noexcept {}
+
+#endif
+
+} // namespace impl
+
+} // namespace lf
+
+#endif /* F1D3A6C2_7B4E_4C1A_9E0D_2A5B8C7E4F61 */
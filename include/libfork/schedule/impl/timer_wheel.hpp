@@ -0,0 +1,375 @@
+#ifndef E646E43B_2252_411E_8BF6_DB74BAAFC47D
+#define E646E43B_2252_411E_8BF6_DB74BAAFC47D
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm> // for min
+#include <array>     // for array
+#include <atomic>    // for atomic, memory_order_relaxed
+#include <chrono>    // for steady_clock, milliseconds, ceil, floor
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t, int64_t
+#include <limits>    // for numeric_limits
+#include <mutex>     // for lock_guard
+#include <optional>  // for optional
+#include <utility>   // for move
+
+#include "libfork/core/ext/context.hpp"    // for nullary_function_t
+#include "libfork/core/impl/spin_lock.hpp" // for spin_lock
+#include "libfork/core/impl/utility.hpp"   // for immovable
+#include "libfork/core/impl/waiter.hpp"    // for waiter, waiter_queue
+#include "libfork/core/macro.hpp"          // for LF_ASSERT
+
+/**
+ * @file timer_wheel.hpp
+ *
+ * @brief A hierarchical timer wheel for parking sleeping coroutines.
+ */
+
+namespace lf::impl {
+
+/**
+ * @brief A coroutine waiting for a deadline.
+ */
+struct timer_node : waiter {
+  /**
+   * @brief The absolute deadline.
+   */
+  std::chrono::steady_clock::time_point deadline;
+  /**
+   * @brief The wheel tick at which this node expires, set by the wheel.
+   */
+  std::uint64_t tick = 0;
+};
+
+/**
+ * @brief A (non-thread-safe) hierarchical timer wheel.
+ *
+ * The wheel has `k_levels` levels each of `k_slots` slots, a slot at level `l` spans `k_slots^l` ticks.
+ * Nodes are inserted at the coarsest level that separates them from the current tick and cascade down
+ * to finer levels as time advances. Nodes beyond the range of the wheel are parked in the first slot
+ * of the top level and re-inserted each time the wheel completes a revolution.
+ */
+class timer_wheel {
+
+  static constexpr std::uint64_t k_bits = 6;
+  static constexpr std::uint64_t k_slots = 1U << k_bits;
+  static constexpr std::uint64_t k_mask = k_slots - 1;
+  static constexpr std::size_t k_levels = 4;
+
+  using queue = waiter_queue<timer_node>;
+
+  static constexpr auto shift(std::size_t level) noexcept -> std::uint64_t { return k_bits * level; }
+
+ public:
+  /**
+   * @brief The number of nodes in the wheel.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+  /**
+   * @brief The next tick that `advance()` will process.
+   */
+  [[nodiscard]] auto current() const noexcept -> std::uint64_t { return m_cur; }
+
+  /**
+   * @brief Insert a node that expires at `node->tick`.
+   *
+   * Returns `false` (and does not insert) if the tick has already been processed.
+   */
+  [[nodiscard]] auto insert(timer_node *node) noexcept -> bool {
+
+    if (node->tick < m_cur) {
+      return false;
+    }
+
+    m_size += 1;
+    place(node);
+    return true;
+  }
+
+  /**
+   * @brief Process every tick up to and including `now`, returns the expired nodes.
+   */
+  [[nodiscard]] auto advance(std::uint64_t now) noexcept -> queue {
+
+    queue expired;
+
+    while (m_cur <= now) {
+
+      if (m_size == 0) {
+        m_cur = now + 1;
+        break;
+      }
+
+      cascade(m_cur);
+
+      queue &slot = m_wheel[0][m_cur & k_mask];
+
+      while (timer_node *node = slot.pop()) {
+        LF_ASSERT(node->tick <= m_cur);
+        m_count[0] -= 1;
+        m_size -= 1;
+        expired.push(node);
+      }
+
+      if (m_count[0] == 0) {
+        // Nothing can expire before the next cascade.
+        m_cur = std::min(now + 1, (m_cur | k_mask) + 1);
+      } else {
+        m_cur += 1;
+      }
+    }
+
+    return expired;
+  }
+
+  /**
+   * @brief The earliest tick at which `advance()` has work to do, empty if the wheel is empty.
+   *
+   * This is conservative, the returned tick may only be a cascade.
+   */
+  [[nodiscard]] auto next() const noexcept -> std::optional<std::uint64_t> {
+
+    if (m_size == 0) {
+      return std::nullopt;
+    }
+
+    std::uint64_t best = std::numeric_limits<std::uint64_t>::max();
+
+    for (std::uint64_t i = 0; i < k_slots - (m_cur & k_mask); ++i) {
+      if (!m_wheel[0][(m_cur + i) & k_mask].empty()) {
+        return m_cur + i;
+      }
+    }
+
+    for (std::size_t l = 1; l < k_levels; ++l) {
+
+      if (m_count[l] == 0) {
+        continue;
+      }
+
+      std::uint64_t base = m_cur >> shift(l);
+
+      // If we are sat on a boundary then the current slot is yet to be cascaded.
+      std::uint64_t first = (m_cur & ((std::uint64_t{1} << shift(l)) - 1)) == 0 ? 0 : 1;
+
+      for (std::uint64_t d = first; d <= k_slots; ++d) {
+        if (!m_wheel[l][(base + d) & k_mask].empty()) {
+          best = std::min(best, (base + d) << shift(l));
+          break;
+        }
+      }
+    }
+
+    return best;
+  }
+
+ private:
+  /**
+   * @brief Put a node in the correct slot relative to `m_cur`.
+   */
+  void place(timer_node *node) noexcept {
+
+    std::uint64_t tick = node->tick;
+
+    LF_ASSERT(tick >= m_cur);
+
+    for (std::size_t l = 0; l < k_levels; ++l) {
+      if ((tick >> shift(l + 1)) == (m_cur >> shift(l + 1))) {
+        m_wheel[l][(tick >> shift(l)) & k_mask].push(node);
+        m_count[l] += 1;
+        return;
+      }
+    }
+
+    // Too far in the future, park in the slot that is cascaded at the start of the next revolution.
+    m_wheel[k_levels - 1][0].push(node);
+    m_count[k_levels - 1] += 1;
+  }
+
+  /**
+   * @brief Redistribute coarse slots that begin at `tick`, coarsest first.
+   */
+  void cascade(std::uint64_t tick) noexcept {
+
+    std::size_t top = 0;
+
+    while (top + 1 < k_levels && (tick & ((std::uint64_t{1} << shift(top + 1)) - 1)) == 0) {
+      top += 1;
+    }
+
+    for (std::size_t l = top; l > 0; --l) {
+
+      queue slot = m_wheel[l][(tick >> shift(l)) & k_mask].take();
+
+      while (timer_node *node = slot.pop()) {
+        m_count[l] -= 1;
+        place(node);
+      }
+    }
+  }
+
+  std::uint64_t m_cur = 0;
+  std::size_t m_size = 0;
+  std::array<std::size_t, k_levels> m_count = {};
+  std::array<std::array<queue, k_slots>, k_levels> m_wheel = {};
+};
+
+/**
+ * @brief A thread-safe timer service shared by the workers of a pool.
+ *
+ * Workers poll the service between tasks and, when idle, at most one worker (the one that armed the
+ * earliest deadline) sleeps with a timeout.
+ */
+class timer_queue : immovable<timer_queue> {
+ public:
+  /**
+   * @brief The clock used for all deadlines.
+   */
+  using clock = std::chrono::steady_clock;
+  /**
+   * @brief The resolution of the wheel.
+   */
+  using tick_t = std::chrono::milliseconds;
+
+  /**
+   * @brief Set a function that wakes an idle worker, called when a new earliest deadline is inserted.
+   *
+   * This must be set before any concurrent access.
+   */
+  void on_alarm(nullary_function_t alarm) noexcept { m_alarm = std::move(alarm); }
+
+  /**
+   * @brief Park a timer node, after this call `node` may have been woken.
+   */
+  void insert(timer_node *node) noexcept {
+
+    node->tick = to_tick_ceil(node->deadline);
+
+    bool inserted = false;
+
+    bool earliest = [&] {
+      std::lock_guard lock{m_lock};
+      inserted = m_wheel.insert(node);
+      m_pending.store(m_wheel.size(), std::memory_order_relaxed);
+      return set_due();
+    }();
+
+    if (!inserted) {
+      // The deadline has already been processed.
+      node->wake();
+      return;
+    }
+
+    if (earliest && m_armed.load(std::memory_order_acquire) > m_due.load(std::memory_order_relaxed)) {
+      if (m_alarm) {
+        m_alarm();
+      }
+    }
+  }
+
+  /**
+   * @brief Wake every coroutine whose deadline has passed.
+   */
+  void poll() noexcept {
+
+    if (m_pending.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+
+    std::uint64_t now = to_tick_floor(clock::now());
+
+    if (now < m_due.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    waiter_queue<timer_node> expired;
+
+    {
+      std::lock_guard lock{m_lock};
+      expired = m_wheel.advance(now);
+      m_pending.store(m_wheel.size(), std::memory_order_relaxed);
+      set_due();
+    }
+
+    while (timer_node *node = expired.pop()) {
+      node->wake();
+    }
+  }
+
+  /**
+   * @brief Attempt to become the worker responsible for the next deadline.
+   *
+   * Returns the deadline to sleep until if this thread should wait with a timeout.
+   */
+  [[nodiscard]] auto try_arm() noexcept -> std::optional<clock::time_point> {
+
+    if (m_pending.load(std::memory_order_relaxed) == 0) {
+      return std::nullopt;
+    }
+
+    std::uint64_t due = m_due.load(std::memory_order_relaxed);
+    std::uint64_t armed = m_armed.load(std::memory_order_relaxed);
+
+    while (due < armed) {
+      if (m_armed.compare_exchange_weak(armed, due, std::memory_order_acq_rel)) {
+        return m_origin + tick_t{due};
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Relinquish the responsibility obtained from `try_arm()`.
+   */
+  void disarm(clock::time_point deadline) noexcept {
+    std::uint64_t expect = to_tick_floor(deadline);
+    m_armed.compare_exchange_strong(expect, k_never, std::memory_order_acq_rel);
+  }
+
+ private:
+  static constexpr std::uint64_t k_never = std::numeric_limits<std::uint64_t>::max();
+
+  /**
+   * @brief Update the cached earliest tick, returns `true` if it moved earlier, requires the lock.
+   */
+  auto set_due() noexcept -> bool {
+    std::uint64_t due = m_wheel.next().value_or(k_never);
+    return m_due.exchange(due, std::memory_order_relaxed) > due;
+  }
+
+  auto to_tick_ceil(clock::time_point time) const noexcept -> std::uint64_t {
+    auto ticks = std::chrono::ceil<tick_t>(time - m_origin).count();
+    return ticks < 0 ? 0 : static_cast<std::uint64_t>(ticks);
+  }
+
+  auto to_tick_floor(clock::time_point time) const noexcept -> std::uint64_t {
+    auto ticks = std::chrono::floor<tick_t>(time - m_origin).count();
+    return ticks < 0 ? 0 : static_cast<std::uint64_t>(ticks);
+  }
+
+  clock::time_point m_origin = clock::now();
+  spin_lock m_lock;
+  timer_wheel m_wheel;
+  std::atomic<std::size_t> m_pending = 0;
+  std::atomic<std::uint64_t> m_due = k_never;
+  std::atomic<std::uint64_t> m_armed = k_never;
+  nullary_function_t m_alarm;
+};
+
+/**
+ * @brief The timer service of the pool that owns the calling worker, `nullptr` if it has none.
+ */
+inline thread_local timer_queue *tls_timers = nullptr;
+
+} // namespace lf::impl
+
+#endif /* E646E43B_2252_411E_8BF6_DB74BAAFC47D */
@@ -0,0 +1,150 @@
+#ifndef E9B27C54_0F3D_4E8A_A1C6_5D74B2E9F083
+#define E9B27C54_0F3D_4E8A_A1C6_5D74B2E9F083
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>    // for min
+#include <cerrno>       // for errno
+#include <cstddef>      // for byte, size_t
+#include <cstdint>      // for int32_t, uint32_t, uint64_t
+#include <limits>       // for numeric_limits
+#include <span>         // for span
+#include <system_error> // for system_error, system_category
+
+#include "libfork/core/ext/handles.hpp"      // for submit_handle
+#include "libfork/core/macro.hpp"            // for LF_THROW
+#include "libfork/core/scheduler.hpp"        // for context_switcher
+#include "libfork/schedule/impl/reactor.hpp" // for io_node, io_op, tls_reactor
+
+#if __has_include(<unistd.h>)
+  #include <sys/types.h> // for off_t
+  #include <unistd.h>    // for pread, pwrite, read, write
+#endif
+
+/**
+ * @file io.hpp
+ *
+ * @brief Awaitables that perform file I/O without blocking a worker.
+ */
+
+#if __has_include(<unistd.h>)
+
+namespace lf::io {
+
+/**
+ * @brief An ``lf::core::context_switcher`` that performs a positional read or write.
+ *
+ * On a `lazy_pool` with io_uring support (see ``LF_USE_URING``) the operation is submitted to the pool's
+ * ring and the coroutine is re-submitted to the worker it suspended on when the operation completes, no
+ * thread is blocked. Otherwise, the operation is performed synchronously by the awaiting worker.
+ *
+ * Awaiting the result yields the number of bytes transferred, errors are reported by throwing a
+ * `std::system_error`.
+ */
+class [[nodiscard("This should be immediately co_awaited")]] io_awaitable : impl::io_node {
+ public:
+  /**
+   * @brief Construct an awaitable for the operation `op` on `fd`.
+   */
+  io_awaitable(impl::io_op kind, int file, void *data, std::size_t size, std::uint64_t pos) noexcept {
+    // The result must fit in a CQE, this is a permitted short transfer.
+    constexpr auto k_max = static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max());
+    op = kind;
+    fd = file;
+    buf = data;
+    len = static_cast<std::uint32_t>(std::min(size, k_max));
+    offset = pos;
+  }
+
+  /**
+   * @brief Perform the operation synchronously if this worker has no reactor.
+   */
+  [[nodiscard]] auto await_ready() noexcept -> bool {
+
+    if (impl::tls_reactor == nullptr || !impl::tls_reactor->valid()) {
+      complete();
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Submit the operation to the reactor, after this call we may already have been resumed.
+   */
+  void await_suspend(submit_handle handle) noexcept {
+    prime(handle);
+    impl::tls_reactor->submit(this);
+  }
+
+  /**
+   * @brief Get the number of bytes transferred.
+   */
+  [[nodiscard]] auto await_resume() const -> std::size_t {
+    if (result < 0) {
+      LF_THROW(std::system_error(static_cast<int>(-result), std::system_category()));
+    }
+    return static_cast<std::size_t>(result);
+  }
+
+ private:
+  /**
+   * @brief Perform the operation synchronously.
+   */
+  void complete() noexcept {
+
+    ::ssize_t res = 0;
+
+    if (offset == k_stream) {
+      res = op == impl::io_op::read ? ::read(fd, buf, len) : ::write(fd, buf, len);
+    } else {
+      auto off = static_cast<::off_t>(offset);
+      res = op == impl::io_op::read ? ::pread(fd, buf, len, off) : ::pwrite(fd, buf, len, off);
+    }
+
+    result = res < 0 ? -errno : res;
+  }
+};
+
+static_assert(context_switcher<io_awaitable>);
+
+/**
+ * @brief Read up to `buf.size()` bytes from `fd` starting at `offset`, like `pread`.
+ */
+inline auto read(int fd, std::span<std::byte> buf, std::uint64_t offset) noexcept -> io_awaitable {
+  return {impl::io_op::read, fd, buf.data(), buf.size(), offset};
+}
+
+/**
+ * @brief Write up to `buf.size()` bytes to `fd` starting at `offset`, like `pwrite`.
+ */
+inline auto write(int fd, std::span<std::byte const> buf, std::uint64_t offset) noexcept -> io_awaitable {
+  // The ring never writes through this pointer.
+  return {impl::io_op::write, fd, const_cast<std::byte *>(buf.data()), buf.size(), offset}; // NOLINT
+}
+
+/**
+ * @brief Read up to `buf.size()` bytes from a stream (pipe, socket, etc.) like `read`.
+ */
+inline auto read(int fd, std::span<std::byte> buf) noexcept -> io_awaitable {
+  return {impl::io_op::read, fd, buf.data(), buf.size(), impl::io_node::k_stream};
+}
+
+/**
+ * @brief Write up to `buf.size()` bytes to a stream (pipe, socket, etc.) like `write`.
+ */
+inline auto write(int fd, std::span<std::byte const> buf) noexcept -> io_awaitable {
+  return io::write(fd, buf, impl::io_node::k_stream);
+}
+
+} // namespace lf::io
+
+#endif
+
+#endif /* E9B27C54_0F3D_4E8A_A1C6_5D74B2E9F083 */
@@ -31,9 +31,11 @@
 #include "libfork/core/scheduler.hpp"             // for scheduler
 #include "libfork/schedule/busy_pool.hpp"         // for busy_vars
 #include "libfork/schedule/ext/event_count.hpp"   // for event_count
-#include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology
+#include "libfork/schedule/ext/numa.hpp"          // for numa_strategy, numa_topology, steal_policy
 #include "libfork/schedule/ext/random.hpp"        // for xoshiro, seed
 #include "libfork/schedule/impl/numa_context.hpp" // for numa_context
+#include "libfork/schedule/impl/reactor.hpp"      // for reactor, tls_reactor
+#include "libfork/schedule/impl/timer_wheel.hpp"  // for tls_timers
 
 /**
  * @file lazy_pool.hpp
@@ -86,6 +88,10 @@ struct lazy_vars : busy_vars {
    * @brief Counters for each numa locality.
    */
   alignas(k_cache_line) std::vector<fat_counters> numa;
+  /**
+   * @brief The io_uring reactor, notifiers must `interrupt()` it after notifying.
+   */
+  alignas(k_cache_line) reactor ring;
 
   // Invariant: *** if (A > 0) then (T >= 1 OR S == 0) ***
 
@@ -109,6 +115,7 @@ struct lazy_vars : busy_vars {
 
     if (numa[tid].thief.fetch_sub(1, acq_rel) == 1) {
       numa[tid].notifier.notify_one();
+      ring.interrupt();
     }
 
     // Then we transition from sleep -> active
@@ -124,6 +131,7 @@ struct lazy_vars : busy_vars {
           domain.notifier.notify_one();
         }
       }
+      ring.interrupt();
     }
 
     resume(handle);
@@ -151,12 +159,18 @@ inline auto lazy_work(numa_topology::numa_node<numa_context<lazy_vars>> node) no
 
   auto &my_numa_vars = my_context->shared().numa[numa_tid]; // node.numa
 
-  lf::nullary_function_t notify{[&my_numa_vars]() {
+  auto &ring = my_context->shared().ring;
+
+  lf::nullary_function_t notify{[&my_numa_vars, &ring]() {
     my_numa_vars.notifier.notify_all();
+    ring.interrupt();
   }};
 
   my_context->init_worker_and_bind(std::move(notify), node);
 
+  tls_timers = &my_context->shared().timers;
+  tls_reactor = &ring;
+
   // Wait for everyone to have set up their numa_vars. If this throws an exception then
   // program terminates due to the noexcept marker.
   my_context->shared().latch_start.arrive_and_wait();
@@ -166,6 +180,8 @@ inline auto lazy_work(numa_topology::numa_node<numa_context<lazy_vars>> node) no
     my_context->shared().stop.test_and_set(std::memory_order_release);
     my_context->shared().latch_stop.arrive_and_wait();
     my_context->finalize_worker();
+    tls_timers = nullptr;
+    tls_reactor = nullptr;
   };
 
   // ----------------------------------- //
@@ -198,6 +214,16 @@ wake_up:
    */
   my_numa_vars.thief.fetch_add(1, release);
 
+  /**
+   * Wake any sleeping tasks whose deadline has passed, this may submit work to us.
+   */
+  my_context->shared().timers.poll();
+
+  /**
+   * Likewise, wake any tasks whose I/O has completed.
+   */
+  ring.poll();
+
   /**
    * First we handle the fast path (work to do) before touching the notifier.
    */
@@ -223,13 +249,20 @@ wake_up:
    *      - The scheduler has not stopped.
    *
    *    Commit/cancel wait on key.
+   *
+   * While there is I/O in flight, one sleeper (the leader) blocks on the ring instead of the notifier.
+   * The lease must be taken before `prepare_wait()` such that a notifier that bumps our key is guaranteed
+   * to observe it and interrupt the ring.
    */
 
+  reactor::lease lead = ring.try_lead();
+
   auto key = my_numa_vars.notifier.prepare_wait();
 
   if (auto *submission = my_context->try_pop_all()) {
     // Check our private **before** `stop`.
     my_numa_vars.notifier.cancel_wait();
+    lead.release();
     my_context->shared().thief_work_sleep(submission, numa_tid);
     goto wake_up;
   }
@@ -241,6 +274,7 @@ wake_up:
     // is still `active` but act stalled.
     my_numa_vars.notifier.cancel_wait();
     my_numa_vars.notifier.notify_all();
+    ring.interrupt();
     my_numa_vars.thief.fetch_sub(1, release);
     return;
   }
@@ -272,8 +306,21 @@ wake_up:
 
   LF_LOG("Goes to sleep");
 
-  // We are safe to sleep.
-  my_numa_vars.notifier.wait(key);
+  // We are safe to sleep, if there are sleeping tasks then (at most) one worker sleeps with a timeout.
+  auto deadline = my_context->shared().timers.try_arm();
+
+  if (lead) {
+    lead.wait(deadline);
+    my_numa_vars.notifier.cancel_wait();
+  } else if (deadline) {
+    my_numa_vars.notifier.wait_until(key, *deadline);
+  } else {
+    my_numa_vars.notifier.wait(key);
+  }
+
+  if (deadline) {
+    my_context->shared().timers.disarm(*deadline);
+  }
   // Note, this could be a spurious wakeup, that doesn't matter because we will just loop around.
   goto wake_up;
 }
@@ -323,15 +370,17 @@ class lazy_pool {
    *
    * @param n The number of worker threads to create, defaults to the number of hardware threads.
    * @param strategy The numa strategy for distributing workers.
+   * @param policy The policy idle workers use to select a victim, leapfrogging is opt-in.
    */
   explicit lazy_pool(std::size_t n = std::thread::hardware_concurrency(),
-                     numa_strategy strategy = numa_strategy::fan)
+                     numa_strategy strategy = numa_strategy::fan,
+                     steal_policy policy = steal_policy::random)
       : m_num_threads(n) {
 
     LF_ASSERT_NO_ASSUME(m_share && !m_share->stop.test(std::memory_order_acquire));
 
     for (std::size_t i = 0; i < n; ++i) {
-      m_worker.push_back(std::make_shared<impl::numa_context<impl::lazy_vars>>(m_rng, m_share));
+      m_worker.push_back(std::make_shared<impl::numa_context<impl::lazy_vars>>(m_rng, m_share, policy));
       m_rng.long_jump();
     }
 
@@ -347,6 +396,14 @@ class lazy_pool {
 
     m_share->numa = std::vector<impl::lazy_vars::fat_counters>(num_numa);
 
+    // When a new earliest deadline appears an idle worker must re-arm its timeout.
+    m_share->timers.on_alarm([vars = m_share.get()]() {
+      for (auto &&domain : vars->numa) {
+        domain.notifier.notify_one();
+      }
+      vars->ring.interrupt();
+    });
+
     [&]() noexcept {
       // All workers must be created, if we fail to create them all then we must terminate else
       // the workers will hang on the latch.
@@ -388,6 +445,8 @@ class lazy_pool {
       var.notifier.notify_all();
     }
 
+    m_share->ring.interrupt();
+
     for (auto &worker : m_threads) {
       worker.join();
     }
@@ -0,0 +1,94 @@
+#ifndef D388F830_BC4F_4A15_AC1B_664C19596E97
+#define D388F830_BC4F_4A15_AC1B_664C19596E97
+
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <chrono> // for steady_clock, duration, time_point, ceil
+#include <thread> // for sleep_until
+
+#include "libfork/core/ext/handles.hpp"          // for submit_handle
+#include "libfork/core/scheduler.hpp"            // for context_switcher
+#include "libfork/schedule/impl/timer_wheel.hpp" // for timer_node, timer_queue, tls_timers
+
+/**
+ * @file sleep.hpp
+ *
+ * @brief Awaitables that suspend a task until a deadline.
+ */
+
+namespace lf {
+
+/**
+ * @brief An ``lf::core::context_switcher`` that resumes the awaiting task after a deadline.
+ *
+ * On the `lazy_pool` and `busy_pool` the coroutine is parked in the pool's timer wheel and re-submitted
+ * to the worker it suspended on once the deadline has passed, no thread is blocked. On other schedulers
+ * this falls back to blocking the worker until the deadline.
+ */
+class [[nodiscard("This should be immediately co_awaited")]] sleep_awaitable : impl::timer_node {
+ public:
+  /**
+   * @brief Construct an awaitable that expires at `when`.
+   */
+  explicit sleep_awaitable(std::chrono::steady_clock::time_point when) noexcept { deadline = when; }
+
+  /**
+   * @brief Don't suspend if the deadline has passed.
+   */
+  [[nodiscard]] auto await_ready() const -> bool {
+
+    if (deadline <= std::chrono::steady_clock::now()) {
+      return true;
+    }
+
+    if (impl::tls_timers == nullptr) {
+      // This scheduler has no timer service.
+      std::this_thread::sleep_until(deadline);
+      return true;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Park this coroutine in the timer wheel.
+   */
+  void await_suspend(submit_handle handle) noexcept {
+    prime(handle);
+    // After this we may have been resumed.
+    impl::tls_timers->insert(this);
+  }
+
+  /**
+   * @brief A no-op.
+   */
+  static auto await_resume() noexcept -> void {}
+};
+
+static_assert(context_switcher<sleep_awaitable>);
+
+/**
+ * @brief Suspend the current task until `when`.
+ */
+template <typename Duration>
+auto sleep_until(std::chrono::time_point<std::chrono::steady_clock, Duration> when) -> sleep_awaitable {
+  return sleep_awaitable{std::chrono::ceil<std::chrono::steady_clock::duration>(when)};
+}
+
+/**
+ * @brief Suspend the current task for at least `dur`.
+ */
+template <typename Rep, typename Period>
+auto sleep_for(std::chrono::duration<Rep, Period> dur) -> sleep_awaitable {
+  return lf::sleep_until(std::chrono::steady_clock::now() + dur);
+}
+
+} // namespace lf
+
+#endif /* D388F830_BC4F_4A15_AC1B_664C19596E97 */
@@ -0,0 +1,155 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <bit>                                   // for bit_cast
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <cmath>                                 // for abs, pow
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for uint64_t
+#include <functional>                            // for plus
+#include <optional>                              // for optional
+#include <random>                                // for mt19937, uniform_real_distribution
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/deterministic_fold.hpp" // for deterministic_fold, deterministic_sum
+#include "libfork/core.hpp"                         // for sync_wait
+#include "libfork/schedule.hpp"                     // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+// Values spanning many orders of magnitude with both signs, a naive sum loses most of its bits.
+auto ill_conditioned(std::size_t n) -> std::vector<double> {
+
+  std::mt19937 rng(static_cast<unsigned>(n));
+  std::uniform_real_distribution<double> mant(-1, 1);
+  std::uniform_int_distribution<int> expo(-20, 20);
+
+  std::vector<double> out(n);
+
+  for (auto &elem : out) {
+    elem = mant(rng) * std::pow(10.0, expo(rng));
+  }
+
+  return out;
+}
+
+auto bits(double x) -> std::uint64_t { return std::bit_cast<std::uint64_t>(x); }
+
+} // namespace
+
+TEMPLATE_TEST_CASE("deterministic sum", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  for (std::size_t n : {0UZ, 1UZ, 1000UZ, 1025UZ, 100'000UZ}) {
+
+    auto v = ill_conditioned(n);
+
+    auto ref = sync_wait(unit_pool{}, deterministic_sum, v);
+    auto tree = sync_wait(unit_pool{}, deterministic_fold, v, std::plus<>{}).value_or(0);
+
+    for (std::size_t threads : {1UZ, 2UZ, 4UZ}) {
+
+      TestType sch = [&] {
+        if constexpr (std::constructible_from<TestType, std::size_t>) {
+          return TestType{threads};
+        } else {
+          return TestType{};
+        }
+      }();
+
+      for (long chunk : {1, 1024, 5000, 1 << 20}) {
+        REQUIRE(bits(sync_wait(sch, deterministic_sum, v, chunk)) == bits(ref));
+
+        auto fold = sync_wait(sch, deterministic_fold, v.begin(), v.end(), chunk, std::plus<>{});
+
+        REQUIRE(bits(fold.value_or(0)) == bits(tree));
+      }
+    }
+
+    // Compare against a sum with the positive and negative parts accumulated in long double.
+
+    long double pos = 0;
+    long double neg = 0;
+
+    for (double x : v) {
+      (x > 0 ? pos : neg) += x;
+    }
+
+    double exact = static_cast<double>(pos + neg);
+
+    REQUIRE(std::abs(ref - exact) <= 1e-12 * std::abs(static_cast<double>(pos)));
+  }
+
+  // Projected floats.
+
+  std::vector<std::pair<int, float>> p(3000, {1, 0.1F});
+
+  auto sch = make_scheduler<TestType>();
+
+  float sum = sync_wait(sch, deterministic_sum, p.begin(), p.end(), 100, [](auto const &x) {
+    return x.second;
+  });
+
+  REQUIRE(std::abs(sum - 300.0F) < 1e-4F);
+}
+
+TEMPLATE_TEST_CASE("deterministic fold", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::vector<int> v(5000);
+
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v[i] = static_cast<int>(i);
+  }
+
+  // Concatenation is associative but not commutative, elements are never reordered.
+
+  auto cat = [](std::string acc, std::string const &x) -> std::string {
+    return acc + x;
+  };
+
+  auto str = [](int x) -> std::string {
+    return std::to_string(x) + ",";
+  };
+
+  std::string ref;
+
+  for (int x : v) {
+    ref += str(x);
+  }
+
+  for (long chunk : {1, 1000, 4096, 10'000}) {
+    REQUIRE(sync_wait(sch, deterministic_fold, v, chunk, cat, str) == ref);
+  }
+
+  REQUIRE(sync_wait(sch, deterministic_fold, v.begin(), v.end(), cat, str) == ref);
+
+  std::vector<int> empty;
+
+  REQUIRE(!sync_wait(sch, deterministic_fold, empty, std::plus<>{}));
+}
+
+// NOLINTEND
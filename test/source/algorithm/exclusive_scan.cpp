@@ -0,0 +1,119 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus
+#include <numeric>                               // for exclusive_scan, iota
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/exclusive_scan.hpp" // for exclusive_scan
+#include "libfork/core.hpp"                     // for sync_wait
+#include "libfork/schedule.hpp"                 // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("exclusive scan", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t n : {0UZ, 1UZ, 2UZ, 100UZ, 10'000UZ}) {
+
+    std::vector<int> in(n);
+
+    std::iota(in.begin(), in.end(), 1);
+
+    std::vector<long> expect(n);
+
+    std::exclusive_scan(in.begin(), in.end(), expect.begin(), 10L);
+
+    for (long chunk : {1, 3, 100, 4096}) {
+
+      std::vector<long> out(n, -1);
+
+      sync_wait(sch, exclusive_scan, in.begin(), in.end(), out.begin(), 10L, chunk, std::plus<>{});
+
+      REQUIRE(out == expect);
+
+      // In place.
+
+      std::vector<long> io(in.begin(), in.end());
+
+      sync_wait(sch, exclusive_scan, io, 10L, chunk, std::plus<>{});
+
+      REQUIRE(io == expect);
+
+      // Projected.
+
+      std::vector<long> dbl(n, -1);
+      std::vector<long> dbl_expect(n);
+
+      std::transform_exclusive_scan(in.begin(), in.end(), dbl_expect.begin(), 0L, std::plus<>{}, [](int x) {
+        return 2 * x;
+      });
+
+      sync_wait(sch, exclusive_scan, in, dbl.begin(), 0L, chunk, std::plus<>{}, [](int x) {
+        return 2 * x;
+      });
+
+      REQUIRE(dbl == dbl_expect);
+    }
+
+    // Default chunk size.
+
+    std::vector<long> out(n, -1);
+
+    sync_wait(sch, exclusive_scan, in, out.begin(), 10L, std::plus<>{});
+
+    REQUIRE(out == expect);
+
+    std::vector<long> io(in.begin(), in.end());
+
+    sync_wait(sch, exclusive_scan, io.begin(), io.end(), 10L, std::plus<>{});
+
+    REQUIRE(io == expect);
+  }
+
+  // Associative but not commutative.
+
+  std::vector<std::string> words(500);
+
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    words[i] = std::to_string(i) + ",";
+  }
+
+  std::vector<std::string> expect(words.size());
+
+  std::exclusive_scan(words.begin(), words.end(), expect.begin(), std::string{">"});
+
+  sync_wait(sch, exclusive_scan, words, std::string{">"}, 7, std::plus<>{});
+
+  REQUIRE(words == expect);
+}
+
+// NOLINTEND
@@ -14,6 +14,7 @@
 #include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
 #include <concepts>                              // for constructible_from
 #include <cstddef>                               // for size_t
+#include <deque>                                 // for deque
 #include <functional>                            // for identity
 #include <span>                                  // for span
 #include <thread>                                // for thread
@@ -138,4 +139,21 @@ TEMPLATE_TEST_CASE("for each (co, co)", "[algorithm][template]", unit_pool, busy
   test(make_scheduler<TestType>(), add_coro, coro_identity);
 }
 
+TEMPLATE_TEST_CASE("for each (non-contiguous)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::deque<int> d(10'000);
+
+  for (int i = 0; auto &elem : d) {
+    elem = i++;
+  }
+
+  lf::sync_wait(sch, lf::for_each, d, 300, add_reg);
+  check(d, 1);
+
+  lf::sync_wait(sch, lf::for_each, d.begin(), d.end(), 300, add_reg, std::identity{});
+  check(d, 2);
+}
+
 // NOLINTEND
\ No newline at end of file
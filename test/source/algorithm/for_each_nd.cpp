@@ -0,0 +1,127 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, all_of
+#include <array>                                 // for array
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t, ptrdiff_t
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/for_each_nd.hpp" // for for_each_nd, for_each_2d, blocked_range
+#include "libfork/core.hpp"                  // for sync_wait, task
+#include "libfork/schedule.hpp"              // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr std::ptrdiff_t nx = 37;
+inline constexpr std::ptrdiff_t ny = 64;
+inline constexpr std::ptrdiff_t nz = 5;
+
+// Visit counts for the async test, async functions cannot capture by reference.
+std::array<std::atomic<int>, nx * ny * nz> visits = {};
+
+constexpr auto visit_coro = [](auto, std::ptrdiff_t i, std::ptrdiff_t j, std::ptrdiff_t k) -> task<> {
+  visits[static_cast<std::size_t>((i * ny + j) * nz + k)] += 1;
+  co_return;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("for each 2d (indices)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::vector<int> v(nx * ny, 0);
+
+  auto add_one = [&](std::ptrdiff_t i, std::ptrdiff_t j) {
+    v[static_cast<std::size_t>(i * ny + j)] += 1;
+  };
+
+  int count = 0;
+
+  for (std::ptrdiff_t tile : {1, 3, 8, 100}) {
+    lf::sync_wait(sch, lf::for_each_2d, nx, ny, tile, tile, add_one);
+    count += 1;
+    REQUIRE(std::ranges::all_of(v, [&](int x) { return x == count; }));
+  }
+
+  lf::sync_wait(sch, lf::for_each_2d, nx, ny, add_one);
+  count += 1;
+  REQUIRE(std::ranges::all_of(v, [&](int x) { return x == count; }));
+
+  // Empty spaces are a no-op.
+  lf::sync_wait(sch, lf::for_each_2d, 0, ny, add_one);
+  lf::sync_wait(sch, lf::for_each_2d, nx, 0, 4, 4, add_one);
+  REQUIRE(std::ranges::all_of(v, [&](int x) { return x == count; }));
+}
+
+TEMPLATE_TEST_CASE("for each 2d (tiles)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  constexpr std::ptrdiff_t tr = 8;
+  constexpr std::ptrdiff_t tc = 16;
+
+  std::vector<int> v(nx * ny, 0);
+  std::atomic<bool> aligned = true;
+
+  lf::sync_wait(sch, lf::for_each_2d, nx, ny, tr, tc, [&](blocked_range<2> const &tile) {
+    // Every tile starts on a tile boundary and is no bigger than a tile.
+    if (tile.lo[0] % tr != 0 || tile.lo[1] % tc != 0 || tile.extent(0) > tr || tile.extent(1) > tc) {
+      aligned = false;
+    }
+    for (std::ptrdiff_t i = tile.lo[0]; i < tile.hi[0]; ++i) {
+      for (std::ptrdiff_t j = tile.lo[1]; j < tile.hi[1]; ++j) {
+        v[static_cast<std::size_t>(i * ny + j)] += 1;
+      }
+    }
+  });
+
+  REQUIRE(aligned);
+  REQUIRE(std::ranges::all_of(v, [](int x) { return x == 1; }));
+}
+
+TEMPLATE_TEST_CASE("for each nd (co)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (auto &elem : visits) {
+    elem = 0;
+  }
+
+  blocked_range<3> box{{0, 0, 0}, {nx, ny, nz}};
+
+  REQUIRE(box.size() == nx * ny * nz);
+
+  lf::sync_wait(sch, lf::for_each_nd, box, std::array<std::ptrdiff_t, 3>{4, 8, 2}, visit_coro);
+
+  REQUIRE(std::ranges::all_of(visits, [](auto const &x) { return x == 1; }));
+
+  lf::sync_wait(sch, lf::for_each_nd, box, visit_coro);
+
+  REQUIRE(std::ranges::all_of(visits, [](auto const &x) { return x == 2; }));
+}
+
+// NOLINTEND
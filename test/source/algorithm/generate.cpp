@@ -0,0 +1,239 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, all_of, equal
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE, REQUIRE_THROWS_AS
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <deque>                                 // for deque
+#include <memory>                                // for allocator, destroy
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/generate.hpp" // for copy, generate, iota, make_first_touch, uninitialized_fill
+#include "libfork/core.hpp"               // for sync_wait
+#include "libfork/schedule.hpp"           // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("iota, generate and copy", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t n : {0UZ, 1UZ, 100UZ, 50'000UZ}) {
+    for (long chunk : {1, 99, 4096}) {
+
+      if (chunk == 1 && n > 100) {
+        continue;
+      }
+
+      std::vector<long> v(n, -1);
+
+      sync_wait(sch, lf::iota, v, chunk, 7);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(v[i] == static_cast<long>(i) + 7);
+      }
+
+      // Non-contiguous output, copies are returned one past the end.
+
+      std::deque<long> d(n + 1, -1);
+
+      auto end = sync_wait(sch, lf::copy, v, d.begin(), chunk);
+
+      REQUIRE(end == d.begin() + static_cast<long>(n));
+      REQUIRE(std::equal(v.begin(), v.end(), d.begin()));
+      REQUIRE(d.back() == -1);
+
+      // Every leaf gets a fresh copy of a stateful generator.
+
+      sync_wait(sch, lf::generate, v.begin(), v.end(), chunk, [k = 0]() mutable {
+        return k++ == 0 ? 1L : 0L;
+      });
+
+      long leaves = 0;
+
+      for (long x : v) {
+        leaves += x;
+      }
+
+      long len = static_cast<long>(n);
+
+      REQUIRE(leaves <= len);
+      REQUIRE(leaves >= (len + chunk - 1) / chunk);
+    }
+  }
+
+  // Default chunk sizes and iota over iterators.
+
+  std::vector<int> v(100'000);
+
+  sync_wait(sch, lf::generate, v, [] {
+    return 3;
+  });
+
+  REQUIRE(std::ranges::all_of(v, [](int x) {
+    return x == 3;
+  }));
+
+  std::vector<std::vector<int>::iterator> its(v.size());
+
+  sync_wait(sch, lf::iota, its.begin(), its.end(), v.begin());
+
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    REQUIRE(its[i] == v.begin() + static_cast<long>(i));
+  }
+
+  std::vector<int> w(v.size());
+
+  REQUIRE(sync_wait(sch, lf::copy, v.begin(), v.end(), w.begin()) == w.end());
+
+  REQUIRE(v == w);
+}
+
+TEMPLATE_TEST_CASE("first touch", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::allocator<std::string> alloc;
+
+  std::size_t const n = 10'000;
+
+  std::string *raw = alloc.allocate(n);
+
+  sync_wait(sch, lf::uninitialized_fill, raw, raw + n, 100, std::string(40, 'x'));
+
+  REQUIRE(std::all_of(raw, raw + n, [](std::string const &str) {
+    return str == std::string(40, 'x');
+  }));
+
+  std::destroy(raw, raw + n);
+  alloc.deallocate(raw, n);
+
+  first_touch_vector<double> a = sync_wait(sch, lf::make_first_touch, n, 64, 1.5);
+
+  REQUIRE(a.size() == n);
+  REQUIRE(std::ranges::all_of(a, [](double x) {
+    return x == 1.5;
+  }));
+
+  first_touch_vector<int> b = sync_wait(sch, lf::make_first_touch, std::size_t{0}, [] {
+    return 2;
+  });
+
+  REQUIRE(b.empty());
+
+  first_touch_vector<int> c = sync_wait(sch, lf::make_first_touch, n, [] {
+    return 2;
+  });
+
+  REQUIRE(std::ranges::all_of(c, [](int x) {
+    return x == 2;
+  }));
+}
+
+#if LF_COMPILER_EXCEPTIONS
+
+namespace {
+
+/**
+ * @brief Counts the live objects in `[lo, hi)`, the copy constructor throws if it constructs at `poison`.
+ *
+ * Copies outside the range (e.g. in the argument of a task) are not counted as the root task's arguments
+ * may be destroyed after `sync_wait` returns.
+ */
+struct counted {
+
+  static inline std::atomic<long> live = 0;
+  static inline counted const *lo = nullptr;
+  static inline counted const *hi = nullptr;
+  static inline counted const *poison = nullptr;
+
+  counted() = default;
+
+  counted(counted const &) {
+    if (this == poison) {
+      throw std::runtime_error("poisoned");
+    }
+    if (lo <= this && this < hi) {
+      live += 1;
+    }
+  }
+
+  auto operator=(counted const &) -> counted & = default;
+
+  ~counted() {
+    if (lo <= this && this < hi) {
+      live -= 1;
+    }
+  }
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("uninitialized_fill rollback", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::allocator<counted> alloc;
+
+  std::size_t const n = 1000;
+
+  counted *raw = alloc.allocate(n);
+
+  counted::lo = raw;
+  counted::hi = raw + n;
+
+  for (std::size_t i : {0UZ, 1UZ, 10UZ, 500UZ, 999UZ}) {
+
+    counted::poison = raw + i;
+
+    auto fill = [&] {
+      sync_wait(sch, lf::uninitialized_fill, raw, raw + n, 10, counted{});
+    };
+
+    REQUIRE_THROWS_AS(fill(), std::runtime_error);
+
+    REQUIRE(counted::live == 0);
+  }
+
+  counted::poison = nullptr;
+
+  sync_wait(sch, lf::uninitialized_fill, raw, raw + n, 10, counted{});
+
+  REQUIRE(counted::live == static_cast<long>(n));
+
+  std::destroy(raw, raw + n);
+
+  REQUIRE(counted::live == 0);
+
+  alloc.deallocate(raw, n);
+}
+
+#endif
+
+// NOLINTEND
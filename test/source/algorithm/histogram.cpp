@@ -0,0 +1,178 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <array>                                 // for array
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus
+#include <random>                                // for mt19937, uniform_int_distribution
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/histogram.hpp" // for histogram, reduce_by_key
+#include "libfork/core.hpp"                // for sync_wait
+#include "libfork/schedule.hpp"            // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+auto random_keys(std::size_t n, int bins) -> std::vector<int> {
+
+  std::mt19937 rng(static_cast<unsigned>(n));
+  std::uniform_int_distribution<int> dist(0, bins - 1);
+
+  std::vector<int> out(n);
+
+  for (auto &elem : out) {
+    elem = dist(rng);
+  }
+
+  return out;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("histogram", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  // With 10'000 bins a stolen split's merge is expensive, with 10 it is not.
+  for (int nbins : {1, 10, 10'000}) {
+    for (std::size_t n : {0UZ, 1UZ, 100UZ, 50'000UZ}) {
+
+      auto keys = random_keys(n, nbins);
+
+      std::vector<long> expect(static_cast<std::size_t>(nbins), 0);
+
+      for (int k : keys) {
+        ++expect[static_cast<std::size_t>(k)];
+      }
+
+      for (long chunk : {1, 99, 4096}) {
+
+        if (chunk == 1 && nbins > 10) {
+          continue;
+        }
+
+        // Stale contents are overwritten.
+        std::vector<long> bins(static_cast<std::size_t>(nbins), 7);
+
+        sync_wait(sch, histogram, keys, bins, chunk);
+
+        REQUIRE(bins == expect);
+      }
+
+      std::vector<long> bins(static_cast<std::size_t>(nbins), 7);
+
+      sync_wait(sch, histogram, keys.begin(), keys.end(), bins);
+
+      REQUIRE(bins == expect);
+    }
+  }
+
+  // Projected into a fixed size array of narrow counters.
+
+  std::vector<std::pair<unsigned char, int>> bytes(3000);
+
+  for (std::size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = {static_cast<unsigned char>(i * 7), static_cast<int>(i)};
+  }
+
+  std::array<int, 256> counts{};
+
+  sync_wait(sch, histogram, bytes, counts, 64, [](auto const &p) {
+    return p.first;
+  });
+
+  for (std::size_t k = 0; k < counts.size(); ++k) {
+    int expect = 0;
+    for (auto const &[b, _] : bytes) {
+      expect += b == k ? 1 : 0;
+    }
+    REQUIRE(counts[k] == expect);
+  }
+}
+
+TEMPLATE_TEST_CASE("reduce by key", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  int const nbins = 17;
+
+  auto keys = random_keys(5000, nbins);
+
+  std::vector<std::pair<int, int>> data;
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    data.emplace_back(keys[i], static_cast<int>(i));
+  }
+
+  auto key = [](std::pair<int, int> const &p) {
+    return p.first;
+  };
+
+  auto val = [](std::pair<int, int> const &p) {
+    return p.second;
+  };
+
+  for (long chunk : {1, 10, 1000, 10'000}) {
+
+    // Sums, accumulated on top of the initial values.
+
+    std::vector<long> sum(nbins, 1);
+    std::vector<long> sum_ref(nbins, 1);
+
+    for (auto const &p : data) {
+      sum_ref[static_cast<std::size_t>(p.first)] += p.second;
+    }
+
+    sync_wait(sch, reduce_by_key, data, sum, chunk, 0L, std::plus<>{}, key, val);
+
+    REQUIRE(sum == sum_ref);
+
+    // Concatenation is associative but not commutative, the order is preserved.
+
+    auto cat = [](std::string acc, auto const &x) -> std::string {
+      if constexpr (std::same_as<std::remove_cvref_t<decltype(x)>, std::string>) {
+        return acc + x;
+      } else {
+        return acc + std::to_string(x) + ",";
+      }
+    };
+
+    std::vector<std::string> str(nbins);
+    std::vector<std::string> str_ref(nbins);
+
+    for (auto const &p : data) {
+      str_ref[static_cast<std::size_t>(p.first)] += std::to_string(p.second) + ",";
+    }
+
+    sync_wait(sch, reduce_by_key, data.begin(), data.end(), str, chunk, std::string{}, cat, key, val);
+
+    REQUIRE(str == str_ref);
+  }
+}
+
+// NOLINTEND
@@ -14,6 +14,7 @@
 #include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
 #include <concepts>                              // for constructible_from
 #include <cstddef>                               // for size_t
+#include <deque>                                 // for deque
 #include <functional>                            // for identity
 #include <span>                                  // for span
 #include <thread>                                // for thread
@@ -135,4 +136,25 @@ TEMPLATE_TEST_CASE("map (co, co)", "[algorithm][template]", unit_pool, busy_pool
   test(make_scheduler<TestType>(), add_coro, coro_identity);
 }
 
+TEMPLATE_TEST_CASE("map (non-contiguous)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::deque<int> d(10'000);
+
+  for (int i = 0; auto &elem : d) {
+    elem = i++;
+  }
+
+  // Contiguous in, non-contiguous out and vice versa.
+
+  std::vector<int> v(d.size());
+
+  lf::sync_wait(sch, lf::map, d, v.begin(), 300, add_reg);
+  check(v, 1);
+
+  lf::sync_wait(sch, lf::map, v, d.begin(), 300, add_reg);
+  check(d, 2);
+}
+
 // NOLINTEND
\ No newline at end of file
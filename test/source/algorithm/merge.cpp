@@ -0,0 +1,168 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, sort, merge, set_union, ...
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for greater
+#include <random>                                // for mt19937, uniform_int_distribution
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/merge.hpp" // for merge, set_union, set_intersection, set_difference, unique_copy
+#include "libfork/core.hpp"            // for sync_wait
+#include "libfork/schedule.hpp"        // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+using pair = std::pair<int, int>;
+
+// Sorted by key, the second member tags the input and position to check stability.
+auto sorted(std::size_t n, int tag, int range) -> std::vector<pair> {
+
+  std::mt19937 rng(static_cast<unsigned>(n) + static_cast<unsigned>(tag));
+  std::uniform_int_distribution<int> dist(0, range);
+
+  std::vector<pair> out;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out.emplace_back(dist(rng), 0);
+  }
+
+  std::ranges::sort(out);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i].second = tag * 1'000'000 + static_cast<int>(i);
+  }
+
+  return out;
+}
+
+constexpr auto key = [](pair const &p) -> int {
+  return p.first;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("merge and set operations", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t n : {0UZ, 1UZ, 100UZ, 5000UZ}) {
+    // Few distinct values forces long runs of equivalent elements.
+    for (int range : {3, 1000}) {
+
+      auto a = sorted(n, 1, range);
+      auto b = sorted(n / 2 + 7, 2, range);
+
+      std::vector<pair> expect(a.size() + b.size());
+      std::vector<pair> out(a.size() + b.size());
+
+      for (long chunk : {1, 7, 100}) {
+
+        auto cmp = std::ranges::less{};
+
+        // Merge.
+
+        auto end = std::ranges::merge(a, b, expect.begin(), cmp, key, key).out;
+        auto got = sync_wait(sch, merge, a, b, out.begin(), chunk, cmp, key, key);
+
+        REQUIRE(got - out.begin() == end - expect.begin());
+        REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+
+        // Union.
+
+        end = std::ranges::set_union(a, b, expect.begin(), cmp, key, key).out;
+        got = sync_wait(sch, set_union, a, b, out.begin(), chunk, cmp, key, key);
+
+        REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+
+        // Intersection.
+
+        end = std::ranges::set_intersection(a, b, expect.begin(), cmp, key, key).out;
+        got = sync_wait(sch,
+                        set_intersection,
+                        a.begin(),
+                        a.end(),
+                        b.begin(),
+                        b.end(),
+                        out.begin(),
+                        chunk,
+                        cmp,
+                        key,
+                        key);
+
+        REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+
+        // Difference.
+
+        end = std::ranges::set_difference(a, b, expect.begin(), cmp, key, key).out;
+        got = sync_wait(sch, set_difference, a, b, out.begin(), chunk, cmp, key, key);
+
+        REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+      }
+
+      // Default chunk size.
+
+      auto end = std::ranges::merge(a, b, expect.begin()).out;
+      auto got = sync_wait(sch, merge, a, b, out.begin());
+
+      REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("unique_copy", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t n : {0UZ, 1UZ, 100UZ, 5000UZ}) {
+    for (int range : {3, 1000}) {
+
+      auto a = sorted(n, 1, range);
+
+      std::vector<pair> expect(a.size());
+      std::vector<pair> out(a.size());
+
+      auto eq = [](int x, int y) {
+        return x == y;
+      };
+
+      for (long chunk : {1, 7, 100}) {
+
+        auto end = std::ranges::unique_copy(a, expect.begin(), eq, key).out;
+        auto got = sync_wait(sch, unique_copy, a, out.begin(), chunk, eq, key);
+
+        REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+      }
+
+      auto end = std::ranges::unique_copy(a.begin(), a.end(), expect.begin()).out;
+      auto got = sync_wait(sch, unique_copy, a.begin(), a.end(), out.begin());
+
+      REQUIRE(std::ranges::equal(out.begin(), got, expect.begin(), end));
+    }
+  }
+}
+
+// NOLINTEND
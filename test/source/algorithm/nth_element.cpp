@@ -0,0 +1,163 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, sort, equal
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for greater
+#include <random>                                // for mt19937, uniform_int_distribution
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/nth_element.hpp" // for nth_element, partial_sort, top_k
+#include "libfork/core.hpp"                  // for sync_wait
+#include "libfork/schedule.hpp"              // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+using pair = std::pair<int, int>;
+
+auto random_vec(std::size_t n, int range) -> std::vector<pair> {
+
+  std::mt19937 rng(static_cast<unsigned>(n) + static_cast<unsigned>(range));
+  std::uniform_int_distribution<int> dist(0, range);
+
+  std::vector<pair> out;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out.emplace_back(dist(rng), static_cast<int>(i));
+  }
+
+  return out;
+}
+
+constexpr auto key = [](pair const &p) -> int {
+  return p.first;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("nth element", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  // Few distinct values stresses the equal-pivot case.
+  for (int range : {0, 3, 1'000'000}) {
+    for (std::size_t n : {0UZ, 1UZ, 2UZ, 1000UZ, 100'000UZ}) {
+
+      auto ref = random_vec(n, range);
+
+      std::ranges::sort(ref, {}, key);
+
+      for (std::size_t nth : {std::size_t{0}, n / 3, n / 2, n - (n > 0 ? 1 : 0), n}) {
+        for (long chunk : {100, 4096}) {
+
+          auto v = random_vec(n, range);
+
+          sync_wait(sch, nth_element, v, v.begin() + static_cast<long>(nth), chunk, std::ranges::less{}, key);
+
+          if (nth == n) {
+            continue;
+          }
+
+          REQUIRE(v[nth].first == ref[nth].first);
+
+          for (std::size_t i = 0; i < n; ++i) {
+            if (i < nth) {
+              REQUIRE(v[i].first <= v[nth].first);
+            } else {
+              REQUIRE(v[i].first >= v[nth].first);
+            }
+          }
+
+          // Still a permutation.
+          auto all = random_vec(n, range);
+          std::ranges::sort(all);
+          std::ranges::sort(v);
+          REQUIRE(v == all);
+        }
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("partial sort and top k", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int range : {3, 1'000'000}) {
+    for (std::size_t n : {0UZ, 1UZ, 1000UZ, 100'000UZ}) {
+
+      auto in = random_vec(n, range);
+
+      auto ref = in;
+
+      std::ranges::sort(ref);
+
+      for (std::size_t k : {std::size_t{0}, std::size_t{1}, std::size_t{10}, n / 2, n}) {
+
+        auto mid = static_cast<long>(k);
+
+        // Partial sort, smallest first (whole pairs so the order is unique).
+
+        if (k <= n) {
+
+          auto v = in;
+
+          sync_wait(sch, partial_sort, v.begin(), v.begin() + mid, v.end(), 64);
+
+          REQUIRE(std::ranges::equal(v.begin(), v.begin() + mid, ref.begin(), ref.begin() + mid));
+
+          std::ranges::sort(v);
+
+          REQUIRE(v == ref);
+        }
+
+        // Top k, largest first, input unchanged.
+
+        std::vector<pair> out(k + 1, pair{-1, -1});
+
+        auto end = sync_wait(sch, top_k, in, out.begin(), mid, 64);
+
+        REQUIRE(end - out.begin() == static_cast<long>(std::min(k, n)));
+
+        REQUIRE(std::ranges::equal(out.begin(), end, ref.rbegin(), ref.rbegin() + (end - out.begin())));
+
+        REQUIRE(out[k] == pair{-1, -1});
+
+        // Projected, default chunk.
+
+        end = sync_wait(sch, top_k, in.begin(), in.end(), out.begin(), mid, std::ranges::less{}, key);
+
+        for (auto it = out.begin(); it != end; ++it) {
+          REQUIRE(it->first == ref[static_cast<std::size_t>(it - out.begin())].first);
+        }
+      }
+
+      REQUIRE(std::ranges::equal(in, random_vec(n, range)));
+    }
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,145 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, stable_sort, sort, equal
+#include <bit>                                   // for bit_cast
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for int64_t, uint8_t, uint32_t
+#include <limits>                                // for numeric_limits
+#include <random>                                // for mt19937_64, uniform_int_distribution, ...
+#include <thread>                                // for thread
+#include <utility>                               // for pair
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/radix_sort.hpp" // for radix_sort
+#include "libfork/core.hpp"                 // for sync_wait
+#include "libfork/schedule.hpp"             // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename T>
+auto random_vec(std::size_t n, std::mt19937_64 &rng) -> std::vector<T> {
+
+  std::vector<T> out(n);
+
+  for (auto &elem : out) {
+    if constexpr (std::floating_point<T>) {
+      elem = std::uniform_real_distribution<T>(-1e6, 1e6)(rng);
+    } else {
+      using lim = std::numeric_limits<T>;
+      elem = std::uniform_int_distribution<T>(lim::min(), lim::max())(rng);
+    }
+  }
+
+  return out;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("radix sort", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::mt19937_64 rng{42};
+
+  for (std::size_t n : {0UZ, 1UZ, 2UZ, 1000UZ, 50'000UZ}) {
+    for (std::ptrdiff_t chunk : {1, 100, 4096}) {
+
+      if (chunk == 1 && n > 1000) {
+        continue;
+      }
+
+      auto u = random_vec<std::uint32_t>(n, rng);
+      auto s = random_vec<std::int64_t>(n, rng);
+      auto f = random_vec<double>(n, rng);
+
+      if (n > 2) {
+        f[0] = -0.0;
+        f[1] = 0.0;
+      }
+
+      auto u_ref = u;
+      auto s_ref = s;
+      auto f_ref = f;
+
+      std::ranges::sort(u_ref);
+      std::ranges::sort(s_ref);
+      std::ranges::stable_sort(f_ref);
+
+      sync_wait(sch, radix_sort, u, chunk);
+      sync_wait(sch, radix_sort, s.begin(), s.end(), chunk);
+      sync_wait(sch, radix_sort, f, chunk);
+
+      REQUIRE(u == u_ref);
+      REQUIRE(s == s_ref);
+      REQUIRE(std::ranges::equal(f, f_ref, [](double a, double b) {
+        return std::bit_cast<std::uint64_t>(a) == std::bit_cast<std::uint64_t>(b) || a == b;
+      }));
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("radix sort (projected)", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::mt19937_64 rng{7};
+
+  std::vector<std::pair<std::int8_t, int>> v(10'000);
+
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    auto key = static_cast<std::int8_t>(std::uniform_int_distribution<int>(-128, 127)(rng));
+    v[i] = {key, static_cast<int>(i)};
+  }
+
+  auto key = [](std::pair<std::int8_t, int> const &p) {
+    return p.first;
+  };
+
+  auto ref = v;
+
+  std::ranges::stable_sort(ref, {}, key);
+
+  // The sort is stable.
+  sync_wait(sch, radix_sort, v, 64, key);
+
+  REQUIRE(v == ref);
+
+  // Already sorted on every byte but one, skips passes.
+  std::vector<std::uint64_t> w(5000, 0xFF00FF00FF00FF00);
+
+  for (std::size_t i = 0; i < w.size(); ++i) {
+    w[i] |= (w.size() - i) << 16;
+  }
+
+  auto w_ref = w;
+
+  std::ranges::sort(w_ref);
+
+  sync_wait(sch, radix_sort, w);
+
+  REQUIRE(w == w_ref);
+}
+
+// NOLINTEND
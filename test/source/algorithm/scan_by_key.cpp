@@ -0,0 +1,123 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus
+#include <random>                                // for mt19937, bernoulli_distribution
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/scan_by_key.hpp" // for scan_by_key
+#include "libfork/core.hpp"                  // for sync_wait
+#include "libfork/schedule.hpp"              // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+template <typename T, typename Bop>
+auto serial(std::vector<T> const &in, std::vector<bool> const &flags, Bop bop) -> std::vector<T> {
+
+  std::vector<T> out;
+
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    if (i == 0 || flags[i]) {
+      out.push_back(in[i]);
+    } else {
+      out.push_back(bop(out.back(), in[i]));
+    }
+  }
+
+  return out;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("scan by key", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::mt19937 rng{42};
+
+  for (std::size_t n : {0UZ, 1UZ, 2UZ, 100UZ, 10'000UZ}) {
+    // Sparse flags give segments spanning many chunks, dense flags many segments per chunk.
+    for (double p : {0.0, 0.001, 0.3, 1.0}) {
+
+      std::bernoulli_distribution coin(p);
+
+      std::vector<long> in(n);
+      std::vector<bool> flags(n);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        in[i] = static_cast<long>(i % 17);
+        flags[i] = coin(rng);
+      }
+
+      auto expect = serial(in, flags, std::plus<>{});
+
+      for (long chunk : {1, 3, 100, 4096}) {
+
+        std::vector<long> out(n, -1);
+
+        sync_wait(sch, scan_by_key, in.begin(), in.end(), flags.begin(), out.begin(), chunk, std::plus<>{});
+
+        REQUIRE(out == expect);
+
+        // In place.
+
+        auto io = in;
+
+        sync_wait(sch, scan_by_key, io, flags.begin(), chunk, std::plus<>{});
+
+        REQUIRE(io == expect);
+      }
+
+      // Default chunk size.
+
+      std::vector<long> out(n, -1);
+
+      sync_wait(sch, scan_by_key, in, flags.begin(), out.begin(), std::plus<>{});
+
+      REQUIRE(out == expect);
+    }
+  }
+
+  // Associative but not commutative.
+
+  std::vector<std::string> words(500);
+  std::vector<bool> flags(words.size());
+
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    words[i] = std::to_string(i) + ",";
+    flags[i] = i % 37 == 0;
+  }
+
+  auto expect = serial(words, flags, std::plus<>{});
+
+  sync_wait(sch, scan_by_key, words.begin(), words.end(), flags.begin(), 7, std::plus<>{});
+
+  REQUIRE(words == expect);
+}
+
+// NOLINTEND
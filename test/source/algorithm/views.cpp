@@ -0,0 +1,123 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <functional>                            // for plus
+#include <optional>                              // for optional, nullopt
+#include <span>                                  // for span
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/algorithm/fold.hpp"  // for fold
+#include "libfork/algorithm/scan.hpp"  // for scan
+#include "libfork/algorithm/views.hpp" // for transform, filter
+#include "libfork/core.hpp"            // for sync_wait
+#include "libfork/schedule.hpp"        // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+constexpr auto square = [](long x) -> long {
+  return x * x;
+};
+
+constexpr auto is_even = [](long x) -> bool {
+  return x % 2 == 0;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Fused fold", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  constexpr long n = 10'000;
+
+  std::vector<long> v;
+
+  for (long i = 1; i <= n; ++i) {
+    v.push_back(i);
+  }
+
+  long squares = 0;
+  long even_squares = 0;
+
+  for (long i = 1; i <= n; ++i) {
+    squares += i * i;
+    even_squares += i % 2 == 0 ? i * i : 0;
+  }
+
+  auto sum = std::plus<>{};
+
+  REQUIRE(sync_wait(sch, fold, v | views::transform(square), sum) == squares);
+  REQUIRE(sync_wait(sch, fold, v | views::transform(square), 100, sum) == squares);
+
+  // Filter before and after the transform.
+  REQUIRE(sync_wait(sch, fold, v | views::filter(is_even) | views::transform(square), sum) == even_squares);
+  REQUIRE(sync_wait(sch, fold, v | views::transform(square) | views::filter(is_even), 10, sum) == even_squares);
+
+  // Nothing passes the filter.
+  auto none = [](long) {
+    return false;
+  };
+
+  REQUIRE(sync_wait(sch, fold, v | views::filter(none), 10, sum) == std::nullopt);
+
+  // Empty range.
+  std::span<long> oops;
+
+  REQUIRE(sync_wait(sch, fold, oops | views::transform(square), sum) == std::nullopt);
+  REQUIRE(sync_wait(sch, fold, oops | views::filter(is_even), sum) == std::nullopt);
+}
+
+TEMPLATE_TEST_CASE("Fused scan", "[algorithm][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  constexpr long n = 10'000;
+
+  std::vector<long> v;
+
+  for (long i = 1; i <= n; ++i) {
+    v.push_back(i);
+  }
+
+  std::vector<long> out(v.size());
+
+  for (long chunk : {1, 10, 1000}) {
+
+    std::ranges::fill(out, 0);
+
+    sync_wait(sch, scan, v | views::transform(square), out.begin(), chunk, std::plus<>{});
+
+    long acc = 0;
+
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      acc += v[i] * v[i];
+      REQUIRE(out[i] == acc);
+    }
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,117 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <memory>                                // for unique_ptr, make_unique
+#include <numeric>                               // for accumulate
+#include <optional>                              // for optional
+#include <thread>                                // for thread
+#include <utility>                               // for declval
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for channel, sync_wait, task, fork, call, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+static_assert(context_switcher<decltype(std::declval<channel<int> &>().send(0))>);
+static_assert(context_switcher<decltype(std::declval<channel<int> &>().recv())>);
+
+inline constexpr auto producer = [](auto, channel<long> &chan, long first, long last) -> task<> {
+  for (long i = first; i < last; ++i) {
+    bool ok = co_await chan.send(i);
+    LF_ASSERT(ok);
+  }
+};
+
+inline constexpr auto consumer = [](auto, channel<long> &chan) -> task<long> {
+  long sum = 0;
+  while (std::optional<long> val = co_await chan.recv()) {
+    sum += *val;
+  }
+  co_return sum;
+};
+
+inline constexpr auto producers = [](auto, channel<long> &chan, long n, long count) -> task<> {
+  for (long i = 0; i < n; ++i) {
+    co_await lf::fork(producer)(chan, i * count, (i + 1) * count);
+  }
+  co_await lf::join;
+  chan.close();
+};
+
+inline constexpr auto pipeline = [](auto, std::size_t capacity, long n, long count) -> task<long> {
+  //
+  channel<long> chan{capacity};
+
+  std::vector<long> sums(static_cast<std::size_t>(n));
+
+  for (auto &sum : sums) {
+    co_await lf::fork(&sum, consumer)(chan);
+  }
+
+  co_await lf::call(producers)(chan, n, count);
+  co_await lf::join;
+
+  co_return std::accumulate(sums.begin(), sums.end(), 0L);
+};
+
+inline constexpr auto closed = [](auto) -> task<bool> {
+  //
+  channel<std::unique_ptr<int>> chan{1};
+
+  bool sent = co_await chan.send(std::make_unique<int>(42));
+
+  chan.close();
+
+  bool late = co_await chan.send(std::make_unique<int>(7));
+
+  std::optional first = co_await chan.recv();
+  std::optional second = co_await chan.recv();
+
+  co_return sent && !late && first && **first == 42 && !second;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Channel pipeline", "[core][channel][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t capacity : {0UZ, 1UZ, 16UZ}) {
+    for (long n : {1, 2, 5}) {
+      long count = 1000;
+      long total = n * count;
+      REQUIRE(sync_wait(sch, pipeline, capacity, n, count) == total * (total - 1) / 2);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Channel close", "[core][channel][template]", unit_pool, busy_pool, lazy_pool) {
+  auto sch = make_scheduler<TestType>();
+  REQUIRE(sync_wait(sch, closed));
+}
+
+// NOLINTEND
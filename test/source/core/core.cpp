@@ -11,6 +11,9 @@
 #include <catch2/catch_test_macros.hpp>          // for INTERNAL_CATCH_NOINTERNAL_CATCH_DEF
 #include <concepts>                              // for constructible_from
 #include <cstddef>                               // for size_t
+#include <cstdint>                               // for uintptr_t
+#include <limits>                                // for numeric_limits
+#include <new>                                   // for bad_alloc
 #include <optional>                              // for optional, operator==
 #include <thread>                                // for thread
 #include <utility>                               // for move
@@ -304,4 +307,52 @@ TEMPLATE_TEST_CASE("Fibonacci - co_alloc", "[core][template]", unit_pool, busy_p
   }
 }
 
+namespace {
+
+struct alignas(64) wide {
+  double lanes[8] = {};
+};
+
+static_assert(lf::co_allocable<wide>);
+
+// Large and over-aligned allocations go to the heap, they must survive forks and steals.
+inline constexpr auto co_big = [](auto co_big, int n) -> lf::task<int> {
+  if (n < 2) {
+    co_return n;
+  }
+
+  auto [big] = co_await lf::co_new<int>(1 << 16);
+  auto [vec] = co_await lf::co_new<wide>(3);
+
+  for (auto &&v : vec) {
+    REQUIRE(reinterpret_cast<std::uintptr_t>(&v) % alignof(wide) == 0);
+  }
+
+  co_await lf::fork(&big.front(), co_big)(n - 1);
+  co_await lf::call(&big.back(), co_big)(n - 2);
+
+  co_await lf::join;
+
+  co_return big.front() + big.back();
+};
+
+inline constexpr auto co_huge = [](auto) -> lf::task<> {
+  auto [huge] = co_await lf::co_new<wide>(std::numeric_limits<std::size_t>::max() / 2);
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Fibonacci - co_alloc heap", "[core][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto schedule = make_scheduler<TestType>();
+
+  for (int i = 1; i < 16; ++i) {
+    REQUIRE(fib(i) == sync_wait(schedule, co_big, i));
+  }
+
+#if LF_COMPILER_EXCEPTIONS
+  REQUIRE_THROWS_AS(sync_wait(schedule, co_huge), std::bad_alloc);
+#endif
+}
+
 // NOLINTEND
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <concepts>                              // for constructible_from
 #include <cstddef>                               // for size_t
 #include <exception>                             // for exception_ptr, current_exception, opera...
+#include <iterator>                              // for ssize
 #include <stdexcept>                             // for runtime_error
 #include <thread>                                // for thread
 #include <utility>                               // for move
@@ -165,4 +166,46 @@ TEMPLATE_TEST_CASE("Integ exceptional fib", "[exception][template]", unit_pool,
   }
 }
 
+#if LF_COMPILER_EXCEPTIONS && defined(LF_AGGREGATE_EXCEPTIONS)
+
+namespace {
+
+constexpr auto validate = [](auto, int i) -> task<> {
+  if (i % 3 == 0) {
+    LF_THROW(std::runtime_error{"invalid"});
+  }
+  co_return;
+};
+
+constexpr auto validate_all = [](auto, int n) -> task<> {
+  for (int i = 0; i < n; ++i) {
+    co_await fork(validate)(i);
+  }
+  co_await join;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Aggregate exceptions", "[exception][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto schedule = make_scheduler<TestType>();
+
+  for (int n = 1; n < 100; ++n) {
+    try {
+      sync_wait(schedule, validate_all, n);
+      FAIL("Expected an exception");
+    } catch (lf::aggregate_exception const &err) {
+      REQUIRE(n > 3);
+      REQUIRE(std::ssize(err.exceptions()) == (n + 2) / 3);
+      for (std::exception_ptr const &ptr : err.exceptions()) {
+        REQUIRE_THROWS_AS(std::rethrow_exception(ptr), std::runtime_error);
+      }
+    } catch (std::runtime_error const &) {
+      REQUIRE(n <= 3);
+    }
+  }
+}
+
+#endif
+
 // NOLINTEND
\ No newline at end of file
@@ -0,0 +1,150 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <optional>                              // for optional
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for async_generator, sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+using sink = async_generator<long>::sink;
+
+// Yield every integer in [lo, hi) from the leaves of a fork-join tree.
+inline constexpr auto range = [](auto range, sink out, long lo, long hi) -> task<> {
+  if (hi - lo <= 8) {
+    for (long i = lo; i < hi; ++i) {
+      if (!co_await out.yield(i)) {
+        co_return;
+      }
+    }
+    co_return;
+  }
+
+  long mid = lo + (hi - lo) / 2;
+
+  co_await lf::fork(range)(out, lo, mid);
+  co_await lf::call(range)(out, mid, hi);
+  co_await lf::join;
+};
+
+inline constexpr auto sum = [](auto, std::size_t capacity, long n) -> task<long> {
+  async_generator<long> gen{capacity};
+
+  co_await gen.fork(range)(0L, n);
+
+  long total = 0;
+
+  while (std::optional<long> val = co_await gen.next()) {
+    total += *val;
+  }
+
+  co_await lf::join;
+
+  co_return total;
+};
+
+inline constexpr auto take = [](auto, long n, long k) -> task<long> {
+  async_generator<long> gen{4};
+
+  co_await gen.fork(range)(0L, n);
+
+  long count = 0;
+
+  while (count < k && co_await gen.next()) {
+    ++count;
+  }
+
+  gen.stop();
+
+  co_await lf::join;
+
+  co_return count;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Async generator", "[core][generator][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t capacity : {0UZ, 1UZ, 16UZ}) {
+    for (long n : {0, 1, 10, 1000}) {
+      REQUIRE(sync_wait(sch, sum, capacity, n) == n * (n - 1) / 2);
+    }
+  }
+
+  for (long k : {0, 1, 100}) {
+    REQUIRE(sync_wait(sch, take, 10'000, k) == k);
+  }
+}
+
+namespace {
+
+inline constexpr auto throwing = [](auto, sink out) -> task<> {
+  co_await out.yield(1);
+  LF_THROW(std::runtime_error("exception"));
+};
+
+inline constexpr auto consume_throwing = [](auto) -> task<bool> {
+  //
+  async_generator<long> gen{4};
+
+  // clang-format off
+
+  LF_TRY {
+    co_await gen.fork(throwing)();
+
+    while (co_await gen.next()) {
+    }
+
+    co_await lf::join;
+  } LF_CATCH_ALL {
+    co_return true;
+  }
+
+  // clang-format on
+
+  co_return false;
+};
+
+} // namespace
+
+#if LF_COMPILER_EXCEPTIONS
+
+TEMPLATE_TEST_CASE("Exceptionally async generator", "[core][generator][template]", unit_pool, busy_pool,
+                   lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, consume_throwing));
+}
+
+#endif
+
+// NOLINTEND
@@ -0,0 +1,141 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, max
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for async_mutex, async_semaphore, sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+inline constexpr auto r_fib = [](auto fib, int n) -> lf::task<int> {
+  if (n < 2) {
+    co_return n;
+  }
+
+  int a, b;
+
+  co_await lf::fork(&a, fib)(n - 1);
+  co_await lf::call(&b, fib)(n - 2);
+
+  co_await lf::join;
+
+  co_return a + b;
+};
+
+struct shared {
+  async_mutex mutex;
+  int count = 0;
+};
+
+inline constexpr auto increment = [](auto, shared &data) -> task<> {
+  co_await data.mutex.lock();
+  // Fork-join while holding the lock, this must not be interleaved with other incrementers.
+  int tmp = data.count;
+  int fib;
+  co_await lf::fork(&fib, r_fib)(10);
+  co_await lf::join;
+  data.count = tmp + (fib == 55 ? 1 : 0);
+  data.mutex.unlock();
+};
+
+inline constexpr auto many_increments = [](auto, int n) -> task<int> {
+  shared data;
+
+  for (int i = 0; i < n; ++i) {
+    co_await lf::fork(increment)(data);
+  }
+  co_await lf::join;
+
+  co_return data.count;
+};
+
+struct limited {
+  async_semaphore sem;
+  std::atomic<int> active = 0;
+  std::atomic<int> peak = 0;
+};
+
+inline constexpr auto bounded = [](auto, limited &data) -> task<> {
+  co_await data.sem.acquire();
+
+  int now = data.active.fetch_add(1) + 1;
+
+  int peak = data.peak.load();
+
+  while (now > peak && !data.peak.compare_exchange_weak(peak, now)) {
+  }
+
+  int fib;
+  co_await lf::call(&fib, r_fib)(12);
+
+  data.active.fetch_sub(1);
+  data.sem.release();
+};
+
+inline constexpr auto many_bounded = [](auto, std::size_t permits, int n) -> task<int> {
+  limited data{async_semaphore{permits}};
+
+  for (int i = 0; i < n; ++i) {
+    co_await lf::fork(bounded)(data);
+  }
+  co_await lf::join;
+
+  co_return data.peak.load();
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Async mutex", "[core][semaphore][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int n : {1, 10, 100, 1000}) {
+    REQUIRE(sync_wait(sch, many_increments, n) == n);
+  }
+
+  async_mutex mutex;
+
+  REQUIRE(mutex.try_lock());
+  REQUIRE(!mutex.try_lock());
+  mutex.unlock();
+  REQUIRE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEMPLATE_TEST_CASE("Async semaphore", "[core][semaphore][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (std::size_t permits : {1UZ, 2UZ, 3UZ}) {
+    int peak = sync_wait(sch, many_bounded, permits, 200);
+    REQUIRE(peak >= 1);
+    REQUIRE(peak <= static_cast<int>(permits));
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,285 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for uint64_t
+#include <stdexcept>                             // for runtime_error
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for task_group, callback_group, deferred_group, ...
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+// An implicit tree in which the number of children of a node depends on its id.
+
+auto num_children(std::uint64_t id) -> std::uint64_t { return (id * 0x9E3779B97F4A7C15ULL >> 59) % 7; }
+
+auto child(std::uint64_t id, std::uint64_t i) -> std::uint64_t { return id * 7 + i + 1; }
+
+auto serial_count(std::uint64_t id, int depth) -> long {
+
+  long count = 1;
+
+  if (depth > 0) {
+    for (std::uint64_t i = 0; i < num_children(id); ++i) {
+      count += serial_count(child(id, i), depth - 1);
+    }
+  }
+
+  return count;
+}
+
+inline constexpr auto slot_count = [](auto count, std::uint64_t id, int depth) -> task<long> {
+  if (depth == 0) {
+    co_return 1;
+  }
+
+  task_group<long> group;
+
+  for (std::uint64_t i = 0; i < num_children(id); ++i) {
+    co_await group.fork(count)(child(id, i), depth - 1);
+  }
+
+  co_await lf::join;
+
+  REQUIRE(group.size() == num_children(id));
+
+  long total = 1;
+
+  for (auto &slot : group) {
+    total += *slot;
+  }
+
+  co_return total;
+};
+
+inline constexpr auto callback_count = [](auto count, std::uint64_t id, int depth) -> task<long> {
+  if (depth == 0) {
+    co_return 1;
+  }
+
+  std::atomic<long> total = 1;
+
+  auto on_result = [&](long x) {
+    total.fetch_add(x, std::memory_order_relaxed);
+  };
+
+  callback_group<long> group{on_result};
+
+  for (std::uint64_t i = 0; i < num_children(id); ++i) {
+    co_await group.fork(count)(child(id, i), depth - 1);
+  }
+
+  co_await lf::join;
+
+  co_return total.load();
+};
+
+inline constexpr auto visit = [](auto visit, std::uint64_t id, int depth, std::atomic<long> &seen) -> task<> {
+  seen.fetch_add(1, std::memory_order_relaxed);
+
+  if (depth == 0) {
+    co_return;
+  }
+
+  task_group<> group;
+
+  for (std::uint64_t i = 0; i < num_children(id); ++i) {
+    co_await group.fork(visit)(child(id, i), depth - 1, seen);
+  }
+
+  co_await lf::join;
+};
+
+// Join one group independently of another child of the same task by scoping it in a called task.
+inline constexpr auto scoped = [](auto, std::uint64_t id, int depth) -> task<long> {
+  long before;
+
+  co_await lf::fork(&before, slot_count)(id, depth);
+
+  task_group<long> group;
+
+  co_await lf::call([&](auto) -> task<> {
+    for (std::uint64_t i = 0; depth > 0 && i < num_children(id); ++i) {
+      co_await group.fork(slot_count)(child(id, i), depth - 1);
+    }
+    co_await lf::join;
+  })();
+
+  long inner = 1;
+
+  for (std::size_t i = 0; i < group.size(); ++i) {
+    inner += group[i];
+  }
+
+  co_await lf::join;
+
+  co_return before == inner ? inner : -1;
+};
+
+// Defer the children (child-stealing) and launch them in two batches.
+inline constexpr auto deferred_count = [](auto, std::uint64_t id, int depth) -> task<long> {
+  if (depth == 0) {
+    co_return 1;
+  }
+
+  deferred_group<decltype(slot_count), std::uint64_t, int> group{slot_count};
+
+  std::uint64_t n = num_children(id);
+
+  for (std::uint64_t i = 0; i < n / 2; ++i) {
+    group.push(child(id, i), depth - 1);
+  }
+
+  co_await group.fork();
+
+  for (std::uint64_t i = n / 2; i < n; ++i) {
+    group.push(child(id, i), depth - 1);
+  }
+
+  co_await group.call();
+
+  co_await lf::join;
+
+  REQUIRE(group.size() == n);
+
+  long total = 1;
+
+  for (std::size_t i = 0; i < group.size(); ++i) {
+    total += group[i];
+  }
+
+  co_return total;
+};
+
+inline constexpr auto tally = [](auto, std::atomic<long> *seen) -> task<> {
+  seen->fetch_add(1, std::memory_order_relaxed);
+  co_return;
+};
+
+inline constexpr auto tally_or_throw = [](auto, std::atomic<long> *seen, int i) -> task<> {
+  if (i < 0) {
+    LF_THROW(std::runtime_error{"negative"});
+  }
+  seen->fetch_add(1, std::memory_order_relaxed);
+  co_return;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Deferred group", "[core][task_group][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int depth : {0, 1, 4, 7}) {
+    REQUIRE(sync_wait(sch, deferred_count, std::uint64_t{3}, depth) == serial_count(3, depth));
+  }
+
+  for (int n : {0, 1, 2, 3, 100, 1000}) {
+
+    std::atomic<long> seen = 0;
+
+    sync_wait(sch, [&](auto) -> task<> {
+      deferred_group<decltype(tally), std::atomic<long> *> group{tally};
+
+      for (int i = 0; i < n; ++i) {
+        group.push(&seen);
+      }
+
+      co_await group.fork();
+      co_await lf::join;
+    });
+
+    REQUIRE(seen.load() == n);
+  }
+
+  // Push more children while the first launch is running.
+  for (int n : {1, 2, 100}) {
+
+    std::atomic<long> seen = 0;
+
+    sync_wait(sch, [&](auto) -> task<> {
+      deferred_group<decltype(tally), std::atomic<long> *> group{tally};
+
+      for (int i = 0; i < n; ++i) {
+        group.push(&seen);
+      }
+
+      co_await group.fork();
+
+      for (int i = 0; i < 10 * n; ++i) {
+        group.push(&seen);
+      }
+
+      co_await group.fork();
+      co_await lf::join;
+    });
+
+    REQUIRE(seen.load() == 11 * n);
+  }
+
+#if LF_COMPILER_EXCEPTIONS
+  for (int n : {1, 2, 100}) {
+
+    std::atomic<long> seen = 0;
+
+    auto throwing = [&](auto) -> task<> {
+      deferred_group<decltype(tally_or_throw), std::atomic<long> *, int> group{tally_or_throw};
+
+      for (int i = 0; i < n; ++i) {
+        group.push(&seen, i == n / 2 ? -1 : i);
+      }
+
+      co_await group.fork();
+      co_await lf::join;
+    };
+
+    REQUIRE_THROWS_AS(sync_wait(sch, throwing), std::runtime_error);
+    REQUIRE(seen.load() == n - 1);
+  }
+#endif
+}
+
+TEMPLATE_TEST_CASE("Task group", "[core][task_group][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int depth : {0, 1, 4, 7}) {
+
+    long expect = serial_count(3, depth);
+
+    REQUIRE(sync_wait(sch, slot_count, std::uint64_t{3}, depth) == expect);
+    REQUIRE(sync_wait(sch, callback_count, std::uint64_t{3}, depth) == expect);
+    REQUIRE(sync_wait(sch, scoped, std::uint64_t{3}, depth) == expect);
+
+    std::atomic<long> seen = 0;
+    sync_wait(sch, visit, std::uint64_t{3}, depth, seen);
+    REQUIRE(seen.load() == expect);
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,210 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <atomic>                                // for atomic
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <expected>                              // for expected, unexpected
+#include <stdexcept>                             // for runtime_error
+#include <string>                                // for string, to_string
+#include <thread>                                // for thread
+#include <tuple>                                 // for tuple
+#include <variant>                               // for get, monostate
+
+#include "libfork/core.hpp"     // for when_all, when_any, when_all_expected, lazy, ...
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+auto fib(int n) -> int {
+  if (n < 2) {
+    return n;
+  }
+  return fib(n - 1) + fib(n - 2);
+}
+
+inline constexpr auto r_fib = [](auto fib, int n) -> task<int> {
+  if (n < 2) {
+    co_return n;
+  }
+
+  auto [a, b] = co_await lf::when_all(lf::lazy(fib)(n - 1), lf::lazy(fib)(n - 2));
+
+  co_return a + b;
+};
+
+inline constexpr auto to_string = [](auto, int n) -> task<std::string> {
+  co_return std::to_string(n);
+};
+
+inline constexpr auto increment = [](auto, std::atomic<int> &count) -> task<> {
+  count.fetch_add(1);
+  co_return;
+};
+
+inline constexpr auto mixed = [](auto, int n) -> task<bool> {
+  std::atomic<int> count = 0;
+
+  auto [a, b, c] = co_await lf::when_all( //
+      lf::lazy(r_fib)(n),
+      lf::lazy(to_string)(n),
+      lf::lazy(increment)(count) //
+  );
+
+  static_assert(std::same_as<decltype(c), std::monostate>);
+
+  co_return a == fib(n) && b == std::to_string(n) && count == 1;
+};
+
+inline constexpr auto any = [](auto, int n) -> task<bool> {
+  std::atomic<int> count = 0;
+
+  auto v = co_await lf::when_any(lf::lazy(r_fib)(n), lf::lazy(to_string)(n), lf::lazy(increment)(count));
+
+  switch (v.index()) {
+    case 0:
+      co_return std::get<0>(v) == fib(n);
+    case 1:
+      co_return std::get<1>(v) == std::to_string(n);
+    default:
+      co_return count == 1;
+  }
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("When all", "[core][when_all][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 20; ++i) {
+    REQUIRE(sync_wait(sch, r_fib, i) == fib(i));
+    REQUIRE(sync_wait(sch, mixed, i));
+  }
+}
+
+TEMPLATE_TEST_CASE("When any", "[core][when_all][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 0; i < 20; ++i) {
+    REQUIRE(sync_wait(sch, any, i));
+  }
+}
+
+namespace {
+
+enum class error { odd };
+
+inline constexpr auto sum_even = [](auto sum_even, int lo, int hi) -> task<std::expected<int, error>> {
+  if (hi - lo == 1) {
+    if (lo % 2 == 1) {
+      co_return std::unexpected{error::odd};
+    }
+    co_return lo;
+  }
+
+  int mid = lo + (hi - lo) / 2;
+
+  auto r = co_await lf::when_all_expected(lf::lazy(sum_even)(lo, mid), lf::lazy(sum_even)(mid, hi));
+
+  if (!r) {
+    co_return std::unexpected{r.error()};
+  }
+
+  co_return std::get<0>(*r) + std::get<1>(*r);
+};
+
+inline constexpr auto ok_void = [](auto, std::atomic<int> &count) -> task<std::expected<void, error>> {
+  count.fetch_add(1);
+  co_return {};
+};
+
+inline constexpr auto expected_mixed = [](auto) -> task<bool> {
+  std::atomic<int> count = 0;
+
+  auto r = co_await lf::when_all_expected(lf::lazy(ok_void)(count), lf::lazy(sum_even)(4, 5));
+
+  static_assert(std::same_as<decltype(r), std::expected<std::tuple<std::monostate, int>, error>>);
+
+  co_return r.has_value() && std::get<1>(*r) == 4 && count == 1;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("When all expected", "[core][when_all][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  for (int i = 1; i < 200; ++i) {
+
+    auto r = sync_wait(sch, sum_even, 0, i);
+
+    if (i == 1) {
+      REQUIRE(r.has_value());
+      REQUIRE(*r == 0);
+    } else {
+      REQUIRE(!r.has_value());
+      REQUIRE(r.error() == error::odd);
+    }
+  }
+
+  REQUIRE(sync_wait(sch, expected_mixed));
+}
+
+namespace {
+
+constexpr auto exception = [](auto) -> task<int> {
+  LF_THROW(std::runtime_error("exception"));
+  co_return 0;
+};
+
+constexpr auto exception_all = [](auto) -> task<bool> {
+  //
+  // clang-format off
+
+  LF_TRY {
+    co_await lf::when_all(lf::lazy(r_fib)(10), lf::lazy(exception)(), lf::lazy(r_fib)(10));
+    co_return false;
+  } LF_CATCH_ALL {
+    co_return true;
+  }
+
+  // clang-format on
+};
+
+} // namespace
+
+#if LF_COMPILER_EXCEPTIONS
+
+TEMPLATE_TEST_CASE("Exceptionally when all", "[core][when_all][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, exception_all));
+}
+
+#endif
+
+// NOLINTEND
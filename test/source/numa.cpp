@@ -8,6 +8,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at https://mozilla.org/MPL/2.0/.
 
+#include <algorithm>                    // for min
 #include <catch2/catch_test_macros.hpp> // for operator==, operator""_catch_sr, AssertionHandler
 #include <cstddef>                      // for size_t
 #include <iostream>                     // for basic_ostream, char_traits, operator<<, cout
@@ -73,6 +74,56 @@ TEST_CASE("split", "[numa]") {
   }
 }
 
+TEST_CASE("split - core aware", "[numa]") {
+
+  numa_topology topo;
+
+  hwloc_topology *raw = topo.split(1).front().topo.get();
+
+  REQUIRE(raw);
+
+  int cores = hwloc_get_nbobjs_by_type(raw, HWLOC_OBJ_CORE);
+  int units = hwloc_get_nbobjs_by_type(raw, HWLOC_OBJ_PU);
+
+  if (cores <= 0) {
+    return;
+  }
+
+  auto n_cores = static_cast<std::size_t>(cores);
+  auto n_units = static_cast<std::size_t>(units);
+
+  for (auto strategy : {numa_strategy::core, numa_strategy::smt}) {
+    for (std::size_t i = 1; i < 2 * n_units; i++) {
+
+      std::vector<numa_topology::numa_handle> singlets = topo.split(i, strategy);
+
+      REQUIRE(singlets.size() == i);
+
+      std::set<std::size_t> unique_cores;
+
+      for (auto const &singlet : singlets) {
+        REQUIRE(hwloc_bitmap_weight(singlet.cpup.get()) == 1);
+        unique_cores.insert(singlet.core);
+      }
+
+      // Every core is used before any core is shared.
+      REQUIRE(unique_cores.size() == std::min(i, n_cores));
+
+      std::set<numa_topology::numa_handle, comp> unique_bitmaps;
+
+      for (auto &singlet : singlets) {
+        unique_bitmaps.emplace(std::move(singlet));
+      }
+
+      if (strategy == numa_strategy::core) {
+        REQUIRE(unique_bitmaps.size() == std::min(i, n_cores));
+      } else {
+        REQUIRE(unique_bitmaps.size() == std::min(i, n_units));
+      }
+    }
+  }
+}
+
 namespace {
 
 void print_distances(lf::impl::detail::distance_matrix const &dist) {
@@ -115,6 +166,30 @@ TEST_CASE("distances", "[numa]") {
   }
 }
 
+TEST_CASE("distances - siblings are closest", "[numa]") {
+
+  numa_topology topo;
+
+  std::size_t max_unique = std::thread::hardware_concurrency();
+
+  for (std::size_t n = 1; n <= 2 * max_unique; n++) {
+
+    std::vector handles = topo.split(n, numa_strategy::smt);
+
+    impl::detail::distance_matrix dist{handles};
+
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < n; j++) {
+        for (std::size_t k = 0; k < n; k++) {
+          if (handles[i].core == handles[j].core && handles[i].core != handles[k].core) {
+            REQUIRE(dist(i, j) < dist(i, k));
+          }
+        }
+      }
+    }
+  }
+}
+
 #endif
 
 TEST_CASE("distribute", "[numa]") {
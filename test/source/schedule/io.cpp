@@ -0,0 +1,185 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min, all_of
+#include <array>                                 // for array
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE, REQUIRE_THROWS_AS
+#include <chrono>                                // for milliseconds
+#include <concepts>                              // for constructible_from, same_as
+#include <cstddef>                               // for byte, size_t
+#include <cstdint>                               // for uint64_t
+#include <cstdio>                                // for tmpfile, fclose, fileno
+#include <span>                                  // for span, as_bytes, as_writable_bytes
+#include <system_error>                          // for system_error
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, call, join, LF_ASSERT
+#include "libfork/schedule.hpp" // for read, write, sleep_for, reactor, busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+#if __has_include(<unistd.h>)
+
+  #include <unistd.h> // for pipe, close
+
+using namespace lf;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+using block = std::array<std::uint64_t, 64>;
+
+inline constexpr auto write_block = [](auto, int fd, std::uint64_t i) -> task<bool> {
+  block data;
+  data.fill(i);
+  std::size_t n = co_await io::write(fd, std::as_bytes(std::span{data}), i * sizeof(block));
+  co_return n == sizeof(block);
+};
+
+inline constexpr auto read_block = [](auto, int fd, std::uint64_t i) -> task<bool> {
+  block data{};
+  std::size_t n = co_await io::read(fd, std::as_writable_bytes(std::span{data}), i * sizeof(block));
+  co_return n == sizeof(block) && std::ranges::all_of(data, [i](std::uint64_t x) { return x == i; });
+};
+
+inline constexpr auto for_blocks = [](auto for_blocks, auto fn, int fd, std::uint64_t lo, std::uint64_t hi)
+    -> task<bool> {
+  bool a, b;
+
+  if (hi - lo == 1) {
+    co_await lf::call(&a, fn)(fd, lo);
+    co_await lf::join;
+    co_return a;
+  }
+
+  std::uint64_t mid = lo + (hi - lo) / 2;
+
+  co_await lf::fork(&a, for_blocks)(fn, fd, lo, mid);
+  co_await lf::call(&b, for_blocks)(fn, fd, mid, hi);
+
+  co_await lf::join;
+
+  co_return a && b;
+};
+
+inline constexpr auto delayed_write = [](auto, int fd, std::uint64_t value) -> task<> {
+  co_await lf::sleep_for(std::chrono::milliseconds{20});
+  std::size_t n = co_await io::write(fd, std::as_bytes(std::span{&value, 1}));
+  LF_ASSERT(n == sizeof(value));
+};
+
+inline constexpr auto pipe_read = [](auto, int read_fd, int write_fd) -> task<std::uint64_t> {
+  // The reader is pending on the ring while the writer sleeps.
+  co_await lf::fork(delayed_write)(write_fd, 42U);
+
+  std::uint64_t value = 0;
+  std::size_t n = co_await io::read(read_fd, std::as_writable_bytes(std::span{&value, 1}));
+
+  co_await lf::join;
+
+  co_return n == sizeof(value) ? value : 0;
+};
+
+inline constexpr auto sleepy_fill = [](auto, int fd, std::uint64_t n) -> task<> {
+  co_await lf::sleep_for(std::chrono::milliseconds{20});
+  // Not through the ring, which is full of readers.
+  for (std::uint64_t i = 0; i < n; ++i) {
+    [[maybe_unused]] auto res = ::write(fd, &i, sizeof(i));
+    LF_ASSERT(res == sizeof(i));
+  }
+};
+
+inline constexpr auto pipe_read_n = [](auto, int fd) -> task<std::uint64_t> {
+  std::uint64_t value = 0;
+  std::size_t n = co_await io::read(fd, std::as_writable_bytes(std::span{&value, 1}));
+  co_return n == sizeof(value) ? value : 0;
+};
+
+inline constexpr auto many_readers = [](auto, int read_fd, int write_fd) -> task<std::uint64_t> {
+  // More readers than the ring has entries, the rest overflow.
+  constexpr std::size_t k_readers = 300;
+
+  std::array<std::uint64_t, k_readers> values{};
+
+  co_await lf::fork(sleepy_fill)(write_fd, k_readers);
+
+  for (std::size_t i = 0; i < k_readers; ++i) {
+    co_await lf::fork(&values[i], pipe_read_n)(read_fd);
+  }
+
+  co_await lf::join;
+
+  std::uint64_t sum = 0;
+
+  for (std::uint64_t value : values) {
+    sum += value;
+  }
+
+  co_return sum;
+};
+
+inline constexpr auto bad_read = [](auto) -> task<std::size_t> {
+  std::array<std::byte, 8> buf;
+  co_return co_await io::read(-1, buf, 0);
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Async I/O", "[schedule][io][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  std::FILE *file = std::tmpfile();
+
+  REQUIRE(file);
+
+  int fd = fileno(file);
+
+  for (std::uint64_t n : {1U, 10U, 1000U}) {
+    REQUIRE(sync_wait(sch, for_blocks, write_block, fd, 0U, n));
+    REQUIRE(sync_wait(sch, for_blocks, read_block, fd, 0U, n));
+  }
+
+  std::fclose(file);
+
+  REQUIRE_THROWS_AS(sync_wait(sch, bad_read), std::system_error);
+
+  if constexpr (!std::same_as<TestType, lazy_pool>) {
+    return; // A blocked reader could starve the writer.
+  }
+
+  if (!impl::reactor{}.valid()) {
+    return;
+  }
+
+  std::array<int, 2> pipe_fd;
+
+  REQUIRE(::pipe(pipe_fd.data()) == 0);
+
+  for (int i = 0; i < 10; ++i) {
+    REQUIRE(sync_wait(sch, pipe_read, pipe_fd[0], pipe_fd[1]) == 42U);
+  }
+
+  REQUIRE(sync_wait(sch, many_readers, pipe_fd[0], pipe_fd[1]) == 300U * 299U / 2U);
+
+  ::close(pipe_fd[0]);
+  ::close(pipe_fd[1]);
+}
+
+#endif
+
+// NOLINTEND
@@ -0,0 +1,79 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE
+#include <cstdint>                               // for uint64_t
+#include <thread>                                // for thread
+
+#include "libfork/core.hpp"     // for task, fork, call, join, sync_wait
+#include "libfork/schedule.hpp" // for busy_pool, lazy_pool, numa_strategy, steal_policy
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+namespace {
+
+/**
+ * @brief A deterministic unbalanced tree, node `id` has `id % 5` children.
+ */
+auto count_serial(std::uint64_t id, int depth) -> std::uint64_t {
+
+  std::uint64_t count = 1;
+
+  if (depth > 0) {
+    for (std::uint64_t i = 0; i < id % 5; ++i) {
+      count += count_serial(id * 5 + i + 1, depth - 1);
+    }
+  }
+
+  return count;
+}
+
+inline constexpr auto count = [](auto count, std::uint64_t id, int depth) -> task<std::uint64_t> {
+  //
+  if (depth == 0 || id % 5 == 0) {
+    co_return std::uint64_t{1};
+  }
+
+  std::uint64_t n = id % 5;
+
+  std::uint64_t res[5] = {};
+
+  for (std::uint64_t i = 0; i + 1 < n; ++i) {
+    co_await lf::fork(&res[i], count)(id * 5 + i + 1, depth - 1);
+  }
+
+  co_await lf::call(&res[n - 1], count)(id * 5 + n, depth - 1);
+
+  co_await lf::join;
+
+  co_return 1 + res[0] + res[1] + res[2] + res[3] + res[4];
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Leapfrog steal policy", "[schedule][template]", busy_pool, lazy_pool) {
+
+  std::size_t n = std::min(4U, std::thread::hardware_concurrency());
+
+  for (auto policy : {steal_policy::random, steal_policy::leapfrog}) {
+
+    TestType sch{n, numa_strategy::fan, policy};
+
+    for (int depth = 1; depth < 12; ++depth) {
+      for (std::uint64_t root = 1; root < 5; ++root) {
+        REQUIRE(sync_wait(sch, count, root, depth) == count_serial(root, depth));
+      }
+    }
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,115 @@
+// Copyright © Conor Williams <conorwilliams@outlook.com>
+
+// SPDX-License-Identifier: MPL-2.0
+
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+#include <algorithm>                             // for min
+#include <catch2/catch_template_test_macros.hpp> // for TEMPLATE_TEST_CASE, TypeList
+#include <catch2/catch_test_macros.hpp>          // for REQUIRE, TEST_CASE
+#include <chrono>                                // for steady_clock, milliseconds
+#include <concepts>                              // for constructible_from
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for uint64_t
+#include <random>                                // for uniform_int_distribution, random_device
+#include <thread>                                // for thread
+#include <vector>                                // for vector
+
+#include "libfork/core.hpp"     // for sync_wait, task, fork, join
+#include "libfork/schedule.hpp" // for sleep_for, timer_wheel, busy_pool, lazy_pool, unit_pool
+
+// NOLINTBEGIN No linting in tests
+
+using namespace lf;
+
+using namespace std::chrono_literals;
+
+namespace {
+
+template <typename T>
+auto make_scheduler() -> T {
+  if constexpr (std::constructible_from<T, std::size_t>) {
+    return T{std::min(4U, std::thread::hardware_concurrency())};
+  } else {
+    return T{};
+  }
+}
+
+using clock = std::chrono::steady_clock;
+
+inline constexpr auto nap = [](auto, std::chrono::milliseconds dur) -> task<bool> {
+  auto start = clock::now();
+  co_await lf::sleep_for(dur);
+  co_return clock::now() - start >= dur;
+};
+
+inline constexpr auto naps = [](auto, int n) -> task<bool> {
+  //
+  std::vector<int> ok(static_cast<std::size_t>(n));
+
+  for (int i = 0; i < n; ++i) {
+    co_await lf::fork(&ok[static_cast<std::size_t>(i)], nap)(std::chrono::milliseconds{(i * 7) % 23});
+  }
+
+  co_await lf::join;
+
+  for (int elem : ok) {
+    if (!elem) {
+      co_return false;
+    }
+  }
+
+  co_return true;
+};
+
+} // namespace
+
+TEST_CASE("Timer wheel", "[schedule][timer]") {
+
+  lf::xoshiro rng{seed, std::random_device{}};
+
+  std::uniform_int_distribution<std::uint64_t> dist{0, std::uint64_t{1} << 26};
+
+  std::vector<impl::timer_node> nodes(1000);
+
+  impl::timer_wheel wheel;
+
+  for (auto &node : nodes) {
+    node.tick = dist(rng);
+    REQUIRE(wheel.insert(&node));
+  }
+
+  REQUIRE(wheel.size() == nodes.size());
+
+  std::size_t expired = 0;
+
+  while (auto next = wheel.next()) {
+
+    REQUIRE(*next >= wheel.current());
+
+    auto out = wheel.advance(*next);
+
+    while (impl::timer_node *node = out.pop()) {
+      // Never early and never later than the earliest pending tick.
+      REQUIRE(node->tick == *next);
+      expired += 1;
+    }
+  }
+
+  REQUIRE(expired == nodes.size());
+  REQUIRE(wheel.size() == 0);
+}
+
+TEMPLATE_TEST_CASE("Sleep for", "[schedule][timer][template]", unit_pool, busy_pool, lazy_pool) {
+
+  auto sch = make_scheduler<TestType>();
+
+  REQUIRE(sync_wait(sch, nap, 0ms));
+  REQUIRE(sync_wait(sch, nap, 5ms));
+  REQUIRE(sync_wait(sch, nap, 150ms)); // Longer than a single level of the wheel.
+  REQUIRE(sync_wait(sch, naps, 100));
+}
+
+// NOLINTEND